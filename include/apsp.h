@@ -0,0 +1,36 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ParallelBFS {
+    // Dense hop-count matrix. Distances saturate at 254; UNREACHABLE marks
+    // pairs with no path. With a tile size, rows and columns are grouped into
+    // tile x tile blocks stored contiguously (row-major inside each block).
+    struct DistanceMatrix {
+        static constexpr uint8_t UNREACHABLE = 255;
+
+        size_t n = 0;
+        size_t tile = 0;  // 0 = plain row-major
+        std::vector<uint8_t> data;
+
+        size_t index(size_t s, size_t t) const {
+            if (tile == 0) return s * n + t;
+            const size_t blocks_per_row = (n + tile - 1) / tile;
+            const size_t block = (s / tile) * blocks_per_row + (t / tile);
+            return block * tile * tile + (s % tile) * tile + (t % tile);
+        }
+        uint8_t at(size_t s, size_t t) const { return data[index(s, t)]; }
+    };
+
+    // Largest vertex count all_pairs_bfs accepts: the matrix alone is V^2 bytes, 4 GiB here
+    constexpr size_t MAX_APSP_VERTICES = size_t(1) << 16;
+
+    // All-pairs BFS that advances `batch_width` sources (64..512, a multiple
+    // of 64) at once: every vertex carries one bit per source in its visited
+    // and frontier bitsets, and a level ORs the frontier words of all
+    // out-neighbors. Source batches run in parallel. Throws
+    // std::invalid_argument above MAX_APSP_VERTICES vertices.
+    DistanceMatrix all_pairs_bfs(const Graph& g, size_t batch_width = 256, size_t tile = 0);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "parallel_bfs.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <vector>
+
+namespace ParallelBFS {
+    // Asynchronous label-correcting BFS with no per-level barrier. Workers pop
+    // (vertex, distance) pairs from their own queue, relax neighbors with an
+    // atomic min and push every improvement back; idle workers steal from the
+    // others. Distances are exact once the queues drain.
+    //
+    // Each queue is ordered by distance / bucket_width and serves its own
+    // lowest bucket, but there is no fence across queues: a worker may run
+    // any number of levels ahead of the others. Correctness comes from label
+    // correction alone: a vertex's distance only ever decreases, and every
+    // distance equals its BFS level once the run returns. Running ahead
+    // costs re-relaxations of vertices whose distance is improved later,
+    // and wider buckets let each queue do that internally as well: 1 costs
+    // about one relaxation per edge, while very wide buckets approach LIFO
+    // label-correcting, which needs exponentially many re-relaxations on
+    // real graphs. Throws std::invalid_argument below 1.
+    void async_bfs(const Graph& g, int source, std::vector<std::atomic<int>>& dist,
+                   ThreadPool& pool, int bucket_width = 1);
+}
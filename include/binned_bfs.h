@@ -0,0 +1,24 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ParallelBFS {
+    // Destination vertices per bin when the caller passes 0: 64K distances
+    // (256 KB) fit in a typical per-core L2
+    constexpr size_t DEFAULT_BIN_VERTICES = size_t(1) << 16;
+
+    // Propagation-blocking BFS. Each level runs in two phases:
+    //  1. binning: threads stream the frontier's edges and append every
+    //     neighbor not yet visited to a per-thread buffer for the bin that
+    //     owns its vertex range (bin_vertices consecutive vertices);
+    //  2. apply: one thread per bin drains that bin from every buffer and
+    //     settles its own slice of dist, which stays cache resident.
+    // Random CAS traffic over all of dist becomes sequential appends plus
+    // bin-local plain stores. All updates of a level carry the same distance,
+    // so only vertex IDs are buffered. bin_vertices is rounded up to a
+    // multiple of 64 so bins own whole words of the visited bitmap.
+    void binned_bfs(const Graph& g, int source, std::vector<std::atomic<int>>& dist,
+                    size_t bin_vertices = 0);
+}
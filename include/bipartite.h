@@ -0,0 +1,17 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <vector>
+
+namespace ParallelBFS {
+    struct BipartiteResult {
+        bool bipartite = true;
+        std::vector<int> color;      // Level parity (0/1) of every vertex; empty when not bipartite
+        std::vector<int> odd_cycle;  // Witness when not bipartite; last vertex links back to the first
+    };
+
+    // Level-synchronous BFS over every component that checks the level parity of
+    // both endpoints of each scanned edge. Stops at the first conflicting edge.
+    // Throws std::invalid_argument unless the graph's metadata marks it
+    // symmetric (undirected, with sorted adjacency lists).
+    BipartiteResult bipartite(const Graph& g);
+}
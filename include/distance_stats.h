@@ -0,0 +1,20 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <vector>
+
+namespace ParallelBFS {
+    struct DistanceHistogram {
+        std::vector<size_t> level_counts; // level_counts[d]: sampled (source, target) pairs at distance d
+        size_t samples = 0;
+        size_t reachable_pairs = 0;       // Pairs with 1 <= d < infinity
+        double reachable_fraction = 0;    // reachable_pairs / (samples * (V - 1))
+        double mean_distance = 0;         // Over reachable pairs
+        int median_distance = 0;          // Over reachable pairs
+    };
+
+    // Runs BFS from `samples` distinct random sources (every vertex when
+    // samples >= V). Sources are spread over the threads; each keeps a visited
+    // bitmap and its own per-level counts, so no distance array is stored.
+    DistanceHistogram distance_histogram(const Graph& g, size_t samples, unsigned seed = 42);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "parallel_bfs.h"
+#include "transport.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ParallelBFS {
+    struct DistributedResult {
+        std::vector<int> dist;   // Every vertex's distance on rank 0; empty on the other ranks
+        int levels = 0;          // Levels expanded, the last one finding nothing new
+        size_t bytes_sent = 0;   // Frontier exchange payload summed over ranks
+        double seconds = 0;      // Slowest rank's traversal, excluding the final gather
+    };
+
+    // 1D-partitioned BFS across the ranks of `transport`. Rank r owns a
+    // contiguous vertex range with a balanced share of the edges, plus the
+    // CSR slice of those vertices. Each level, ranks expand their own
+    // frontier, settle local discoveries directly and batch remote ones per
+    // owner into a single all-to-all exchange. A per-rank bitmap keeps a
+    // remote vertex from being sent more than once.
+    //
+    // Every rank must call this with the same graph and source. Ranks only
+    // read their own slice of g; a cluster launch would load just that slice.
+    // Runs single-threaded inside each rank (one rank per core).
+    DistributedResult distributed_bfs(const Graph& g, int source, Distributed::Transport& transport);
+
+    // Processor grid used by distributed_bfs_2d: rows x cols == ranks, as
+    // square as the rank count allows (a prime count degenerates to 1 x ranks)
+    std::pair<int, int> grid_shape(int ranks);
+
+    // 2D (checkerboard) BFS across the ranks of `transport`. Vertices are
+    // split into one block per rank; rank (i, j) of the grid stores the edges
+    // from its processor column's blocks into its processor row's blocks, so
+    // a hub's edges spread over a whole grid column instead of one rank.
+    // Each level has two phases, each talking to only rows or cols peers:
+    //   expand  - owners send their frontier block along the processor column
+    //   fold    - discoveries go along the processor row to their owners
+    // Vertex sets travel as bitmaps or varint-coded gap lists, whichever is
+    // smaller for their density. Same calling rules as distributed_bfs.
+    DistributedResult distributed_bfs_2d(const Graph& g, int source, Distributed::Transport& transport);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "parallel_backend.h"
+#include "thread_pool.h"
+#include "workspace.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Level-synchronous frontier helpers shared by the BFS-style engines.
+namespace Frontier {
+    // Expands every vertex of `current` in parallel. `visit(u, out)` appends the
+    // vertices it discovers to the thread-private `out`; the private lists are
+    // concatenated into `next` once the level is done. The private lists are
+    // the local() buffers of `workspace`, which engines lease once per query.
+    template <typename Visit>
+    void expand(Workspace& workspace, const std::vector<int>& current, std::vector<int>& next, Visit&& visit) {
+        Parallel::for_chunks(current.size(), 64, [&](size_t begin, size_t end, size_t thread) {
+            std::vector<int>& out = workspace.local(thread);
+            for (size_t i = begin; i < end; ++i) {
+                visit(current[i], out);
+            }
+        });
+
+        next.clear();
+        workspace.drain_locals(next);
+    }
+
+    template <typename Visit>
+    void expand(const std::vector<int>& current, std::vector<int>& next, Visit&& visit) {
+        Workspace::Lease workspace(Parallel::max_threads());
+        expand(*workspace, current, next, std::forward<Visit>(visit));
+    }
+
+    // Same as expand() on a persistent pool; chunks of the frontier are
+    // work-stolen between the pool's own workers.
+    template <typename Visit>
+    void expand(ThreadPool& pool, const std::vector<int>& current, std::vector<int>& next, Visit&& visit) {
+        Workspace::Lease workspace(pool.size());
+        pool.parallel_for(current.size(), 64, [&](size_t begin, size_t end, size_t worker) {
+            std::vector<int>& out = workspace->local(worker);
+            for (size_t i = begin; i < end; ++i) {
+                visit(current[i], out);
+            }
+        });
+
+        next.clear();
+        workspace->drain_locals(next);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Concurrent frontier made of per-thread chunk lists. Each thread appends to
+// its own open chunk and publishes full chunks onto a lock-free stack, so
+// insertion is O(1) amortized with no shared lock. seal() then cuts the
+// published chunks into small ranges for parallel iteration; vertices are
+// never copied or merged into one array. Chunks are recycled by clear().
+class FrontierBag {
+public:
+    static constexpr size_t CHUNK_CAPACITY = 1024;
+    static constexpr size_t SPLIT_SIZE = 256;  // Max vertices per iteration range
+
+    struct Chunk {
+        Chunk* next = nullptr;
+        size_t size = 0;
+        int items[CHUNK_CAPACITY];
+    };
+
+    struct Range {
+        const int* begin;
+        const int* end;
+    };
+
+    explicit FrontierBag(size_t threads);
+    ~FrontierBag();
+
+    FrontierBag(const FrontierBag&) = delete;
+    FrontierBag& operator=(const FrontierBag&) = delete;
+
+    // Safe to call concurrently as long as each thread uses its own index
+    void insert(size_t thread, int v) {
+        Chunk*& open = slots_[thread].open;
+        if (open == nullptr || open->size == CHUNK_CAPACITY) {
+            if (open != nullptr) publish(open);
+            open = acquire(thread);
+        }
+        open->items[open->size++] = v;
+    }
+
+    // Publishes partially filled chunks and builds ranges(). Call outside parallel regions.
+    void seal();
+
+    // Returns every chunk to the free lists, keeping their memory
+    void clear();
+
+    const std::vector<Range>& ranges() const noexcept { return ranges_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t threads() const noexcept { return slots_.size(); }
+
+private:
+    struct alignas(64) Slot {
+        Chunk* open = nullptr;
+        std::vector<Chunk*> free;
+        std::vector<Chunk*> owned;
+    };
+
+    void publish(Chunk* chunk) {
+        chunk->next = published_.load(std::memory_order_relaxed);
+        while (!published_.compare_exchange_weak(chunk->next, chunk,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {}
+    }
+
+    Chunk* acquire(size_t thread);
+
+    std::vector<Slot> slots_;
+    std::atomic<Chunk*> published_{nullptr};
+    std::vector<Chunk*> sealed_;
+    std::vector<Range> ranges_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace ParallelBFS {
+    struct GraphStats {
+        size_t vertices = 0;
+        size_t edges = 0;
+        size_t min_degree = 0;            // Out-degrees
+        size_t max_degree = 0;
+        double mean_degree = 0;
+        std::vector<size_t> degree_histogram; // [0]: degree 0, [k]: degree in [2^(k-1), 2^k)
+        size_t isolated = 0;              // No out-edges and no in-edges
+        size_t self_loops = 0;
+        size_t duplicate_edges = 0;       // Repeats of a target already in the same list
+        size_t invalid_targets = 0;       // Targets outside [0, V)
+        size_t unsorted_lists = 0;        // Adjacency lists not in ascending order
+        size_t reciprocated = 0;          // Valid non-loop edges u -> v with v -> u present
+        double symmetry_ratio = 0;        // reciprocated over valid non-loop edges, 1 when there are none
+        GraphMetadata metadata;           // The same facts the engines read, for Graph::set_metadata
+
+        // No invalid targets, self-loops or duplicates. Unsorted lists are
+        // reported but allowed: no engine needs them sorted, and the metadata
+        // just does not call such a graph symmetric
+        bool clean() const noexcept {
+            return invalid_targets == 0 && self_loops == 0 && duplicate_edges == 0;
+        }
+    };
+
+    // One parallel pass over the vertices for degrees, loops, duplicates and
+    // invalid targets, and one over the edges for symmetry, looking each
+    // reverse edge up by binary search, in a scratch copy of the edges with
+    // the unsorted lists sorted if there are any. O(V + E log d), which
+    // can outlast a BFS on large graphs, so main runs it only on request and
+    // otherwise settles for Graph::validate(). It yields the graph's metadata
+    // so that need not be computed again. Throws
+    // std::invalid_argument if the offsets are not a CSR over the edges.
+    GraphStats graph_stats(const Graph& g);
+
+    void print_graph_stats(const GraphStats& stats, std::ostream& out);
+}
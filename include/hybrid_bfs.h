@@ -0,0 +1,58 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ParallelBFS {
+    // Direction-optimizing BFS. Small frontiers expand top-down from a vertex
+    // list; once the frontier's out-edges exceed the unexplored edges / alpha
+    // the search switches to bottom-up levels, where every unvisited vertex
+    // scans its in-neighbors against a frontier bitmap and stops at the first
+    // hit. It returns to top-down when the frontier shrinks below V / beta.
+    //
+    // The bitmap work (neighbor membership, frontier sizing, bitmap-to-list
+    // conversion) runs on the runtime-dispatched kernels in simd_kernels.h.
+    // Bottom-up needs in-edges: the transpose is built once here unless the
+    // graph's metadata marks it symmetric. Top-down levels expand the
+    // metadata's hubs edge-parallel, so one hub cannot hold up a level.
+    //
+    // The traversal is compiled once per graph shape - 16- or 32-bit IDs,
+    // symmetric or not - and run() picks the instantiation, so the inner
+    // loops carry no per-vertex checks for either. Graphs of up to 65536
+    // vertices keep their bottom-up lists as 16-bit IDs, which halves the
+    // bytes scanned and doubles the IDs per SIMD load.
+    class HybridBFS {
+    public:
+        explicit HybridBFS(const Graph& g, double alpha = 15.0, double beta = 18.0);
+
+        void run(int source, std::vector<std::atomic<int>>& dist);
+
+        // Levels the last run() expanded bottom-up
+        size_t bottom_up_levels() const noexcept { return bottom_up_levels_; }
+        bool symmetric() const noexcept { return in_offsets_.empty(); }
+        bool narrow_ids() const noexcept { return narrow_; }
+
+    private:
+        template <typename Id, bool Symmetric>
+        void run_as(int source, std::vector<std::atomic<int>>& dist);
+        template <typename Id, bool Symmetric>
+        size_t bottom_up_step(int level, std::vector<std::atomic<int>>& dist);
+        void bitmap_to_frontier(std::vector<int>& frontier) const;
+
+        const Graph& g_;
+        double alpha_, beta_;
+
+        // Transpose CSR; empty when g_ is symmetric and serves as its own transpose
+        std::vector<int> in_offsets_;
+        std::vector<int> in_edges_;
+        // With narrow IDs the bottom-up lists live here instead: in_edges_, or
+        // g_.edges when symmetric, as 16-bit IDs
+        bool narrow_ = false;
+        std::vector<uint16_t> narrow_in_edges_;
+
+        std::vector<uint64_t> front_, next_, visited_;
+        size_t bottom_up_levels_ = 0;
+    };
+}
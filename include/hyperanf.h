@@ -0,0 +1,26 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <vector>
+
+namespace ParallelBFS {
+    struct HyperANFConfig {
+        int log2_registers = 6;        // 2^k one-byte HyperLogLog registers per vertex
+        size_t memory_limit_bytes = 0; // Caps both register arrays; lowers log2_registers to fit (0 = no cap)
+        int max_iterations = 1000;
+        double effective_fraction = 0.9;
+        unsigned seed = 0;
+    };
+
+    struct NeighborhoodFunction {
+        std::vector<double> pairs_within; // pairs_within[t]: estimated pairs (x, y) with d(x, y) <= t
+        double effective_diameter = 0;    // Interpolated t where pairs_within reaches effective_fraction of its final value
+        int log2_registers = 0;           // Register count actually used after applying the memory cap
+        size_t register_bytes = 0;        // Memory held by the register arrays
+    };
+
+    // HyperANF: every vertex keeps a HyperLogLog counter of the vertices it
+    // reaches within t hops along out-edges; each iteration takes the register
+    // max over its out-neighbors in parallel until no counter changes.
+    NeighborhoodFunction hyperanf(const Graph& g, const HyperANFConfig& config = {});
+}
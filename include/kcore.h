@@ -0,0 +1,18 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <vector>
+
+namespace ParallelBFS {
+    struct CoreDecomposition {
+        std::vector<int> coreness;  // Largest k such that the vertex is in the k-core
+        std::vector<int> order;     // Degeneracy ordering (peeling order), a permutation of the vertices
+        int degeneracy = 0;         // Maximum coreness
+    };
+
+    // Parallel peeling k-core decomposition. Each round peels the frontier of
+    // vertices whose remaining degree is at most k, decrementing neighbor
+    // degrees atomically; vertices that drop to k join the next frontier.
+    // Throws std::invalid_argument unless the graph's metadata marks it
+    // symmetric (undirected, with sorted adjacency lists).
+    CoreDecomposition kcore(const Graph& g);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// CSR with 64-bit offsets and 32-bit neighbor IDs: past 2^31 edges, where
+// Graph's int offsets overflow, at 4 bytes per edge plus 8 per vertex.
+struct CompactGraph {
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> edges;
+
+    size_t vertex_count() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t edge_count() const noexcept { return edges.size(); }
+    size_t memory_bytes() const noexcept {
+        return offsets.size() * sizeof(uint64_t) + edges.size() * sizeof(uint32_t);
+    }
+};
+
+// Low-memory profile for graphs that only just fit on one host: a loader
+// that never materializes an edge-pair list and a BFS whose state is
+// 11 bits per vertex instead of Graph plus atomic<int> distances.
+namespace LowMemory {
+    constexpr uint8_t UNREACHED = 255;
+    constexpr uint8_t LEVEL_CAP = 254;  // Deeper levels are stored as LEVEL_CAP
+
+    struct MemoryProjection {
+        size_t graph_bytes = 0;      // CompactGraph, which is also the load-time peak
+        size_t traversal_bytes = 0;  // Visited and two frontier bitmaps plus the level array
+        size_t peak_bytes() const noexcept { return graph_bytes + traversal_bytes; }
+    };
+
+    MemoryProjection project(size_t vertices, size_t edges);
+
+    // Builds the CSR in place from a "u v [w]" edge list in two streaming
+    // passes: the first counts out-degrees straight into the offset array,
+    // the second writes each neighbor into its final slot. Peak memory is the
+    // finished CSR; the edge list need not be sorted, weights are ignored.
+    // Once the first pass knows the graph's size, the projected peak for
+    // loading plus traversal is written to `report`, if given.
+    CompactGraph load(const std::string& filename, std::ostream* report = nullptr);
+
+    // Narrows a Graph for the low-memory BFS
+    CompactGraph compact(const Graph& g);
+
+    struct BFSResult {
+        size_t reached = 0;  // Vertices with a level, source included
+        int levels = 0;      // Exact depth of the traversal, even past LEVEL_CAP
+    };
+
+    // Level-synchronous top-down BFS. Frontiers are bitmaps, so traversal
+    // memory is fixed at 3 * V / 8 bytes plus V bytes for `level`, which is
+    // resized and filled with each vertex's depth or UNREACHED.
+    BFSResult bfs(const CompactGraph& g, uint32_t source, std::vector<uint8_t>& level);
+}
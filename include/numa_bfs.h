@@ -0,0 +1,54 @@
+#pragma once
+#include "parallel_bfs.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ParallelBFS {
+    // NUMA-partitioned BFS. Vertices are split into one contiguous range per
+    // node with balanced edge counts. Each node's CSR slice, distance range and
+    // frontier are allocated and first touched by pool workers pinned to that
+    // node, so they land in node-local memory. During a level, workers only
+    // update distances they own; discoveries of vertices owned by another
+    // node go into per-worker mailboxes that the owning node drains after a
+    // barrier, instead of remote atomics.
+    //
+    // With one detected node (or nodes == 1) this is a plain level-synchronous
+    // BFS. Asking for more nodes than the machine has partitions the graph the
+    // same way without pinning, which keeps the mailbox path testable anywhere.
+    class NumaBFS {
+    public:
+        // nodes = 0 uses the detected NUMA nodes; threads = 0 uses every allowed CPU
+        explicit NumaBFS(const Graph& g, size_t nodes = 0, size_t threads = 0);
+
+        void run(int source, std::vector<std::atomic<int>>& dist);
+
+        size_t nodes() const noexcept { return slices_.size(); }
+        size_t owner(int v) const;
+        bool pinned() const noexcept { return pinned_; }
+
+    private:
+        struct Slice {
+            int first = 0, last = 0;                 // Owned vertices [first, last)
+            std::vector<int> offsets;                // Local CSR over owned vertices
+            std::vector<int> edges;                  // Global neighbor IDs
+            std::unique_ptr<std::atomic<int>[]> dist;
+            std::vector<int> frontier;
+        };
+
+        size_t node_of(size_t worker) const { return worker % slices_.size(); }
+        size_t rank_of(size_t worker) const { return worker / slices_.size(); }
+        size_t ranks(size_t node) const;
+
+        std::vector<int> bounds_;  // bounds_[n] = first vertex of node n, plus V
+        std::vector<Slice> slices_;
+        std::unique_ptr<ThreadPool> pool_;
+        bool pinned_ = false;
+
+        // Per-worker discovery buffers: local_next_[w] for own node, outbox_[w][n] for node n
+        std::vector<std::vector<int>> local_next_;
+        std::vector<std::vector<std::vector<int>>> outbox_;
+    };
+}
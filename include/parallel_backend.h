@@ -0,0 +1,165 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Parallel primitives used by the engines and loaders. The backend is fixed
+// at build time by the BFS_PARALLEL_BACKEND CMake option:
+//   BFS_BACKEND_OPENMP   OpenMP parallel regions (default)
+//   BFS_BACKEND_THREADS  std::thread workers from a built-in ThreadPool
+//   BFS_BACKEND_SERIAL   Everything runs on the calling thread
+#if !defined(BFS_BACKEND_OPENMP) && !defined(BFS_BACKEND_THREADS) && !defined(BFS_BACKEND_SERIAL)
+#define BFS_BACKEND_OPENMP
+#endif
+
+#if defined(BFS_BACKEND_OPENMP)
+#include <omp.h>
+#elif defined(BFS_BACKEND_THREADS)
+#include "thread_pool.h"
+#endif
+
+namespace Parallel {
+    const char* backend_name();
+
+    // Threads a parallel call will use
+    size_t max_threads();
+    void set_num_threads(size_t threads);
+
+#if defined(BFS_BACKEND_THREADS)
+    namespace detail {
+        ThreadPool& pool();
+        // True on a thread already running backend work; nested calls run inline
+        bool& nested();
+    }
+#endif
+
+    // Runs fn(thread, threads) once on every thread of the team.
+    template <typename F>
+    void region(F&& fn) {
+#if defined(BFS_BACKEND_OPENMP)
+        #pragma omp parallel
+        fn(static_cast<size_t>(omp_get_thread_num()), static_cast<size_t>(omp_get_num_threads()));
+#elif defined(BFS_BACKEND_THREADS)
+        if (detail::nested()) {
+            fn(size_t(0), size_t(1));
+            return;
+        }
+        ThreadPool& pool = detail::pool();
+        pool.run([&](size_t worker) {
+            detail::nested() = true;
+            fn(worker, pool.size());
+            detail::nested() = false;
+        });
+#else
+        fn(size_t(0), size_t(1));
+#endif
+    }
+
+    // Calls fn(begin, end, thread) over [0, n). grain > 0 hands out chunks of
+    // that size dynamically; grain == 0 gives every thread one static block.
+    template <typename F>
+    void for_chunks(size_t n, size_t grain, F&& fn) {
+        if (n == 0) return;
+#if defined(BFS_BACKEND_OPENMP)
+        if (grain == 0) {
+            #pragma omp parallel
+            {
+                const size_t t = omp_get_thread_num();
+                const size_t T = omp_get_num_threads();
+                if (n * t / T < n * (t + 1) / T) fn(n * t / T, n * (t + 1) / T, t);
+            }
+        } else {
+            const size_t chunks = (n + grain - 1) / grain;
+            #pragma omp parallel
+            {
+                const size_t t = omp_get_thread_num();
+                #pragma omp for schedule(dynamic, 1)
+                for (size_t c = 0; c < chunks; ++c) {
+                    fn(c * grain, std::min(n, (c + 1) * grain), t);
+                }
+            }
+        }
+#elif defined(BFS_BACKEND_THREADS)
+        if (detail::nested()) {
+            fn(size_t(0), n, size_t(0));
+            return;
+        }
+        ThreadPool& pool = detail::pool();
+        if (grain == 0) grain = (n + pool.size() - 1) / pool.size();
+        pool.parallel_for(n, grain, [&](size_t begin, size_t end, size_t worker) {
+            detail::nested() = true;
+            fn(begin, end, worker);
+            detail::nested() = false;
+        });
+#else
+        (void)grain;
+        fn(size_t(0), n, size_t(0));
+#endif
+    }
+
+    // Calls fn(i) for every i in [0, n)
+    template <typename F>
+    void parallel_for(size_t n, F&& fn, size_t grain = 0) {
+        for_chunks(n, grain, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) fn(i);
+        });
+    }
+
+    template <typename T> class PerThread;
+
+    // Folds fn(i) over [0, n) with op, starting every thread from identity
+    template <typename T, typename F, typename Op>
+    T reduce(size_t n, T identity, F&& fn, Op&& op, size_t grain = 0) {
+        PerThread<T> partial(identity);
+        for_chunks(n, grain, [&](size_t begin, size_t end, size_t thread) {
+            T acc = partial[thread];
+            for (size_t i = begin; i < end; ++i) acc = op(acc, fn(i));
+            partial[thread] = acc;
+        });
+
+        T result = identity;
+        partial.for_each([&](const T& value) { result = op(result, value); });
+        return result;
+    }
+
+    template <typename T, typename F>
+    T sum(size_t n, F&& fn, size_t grain = 0) {
+        return reduce(n, T(0), std::forward<F>(fn), [](T a, T b) { return a + b; }, grain);
+    }
+
+    // In-place exclusive prefix sum over per-block totals; returns the grand total.
+    // Serial: callers scan one entry per thread or block, never per element.
+    template <typename T>
+    T exclusive_scan(std::vector<T>& values) {
+        T running = 0;
+        for (T& v : values) {
+            T next = running + v;
+            v = running;
+            running = next;
+        }
+        return running;
+    }
+
+    // One cache-line padded slot per thread, indexed by the thread argument
+    // that region() and for_chunks() pass in
+    template <typename T>
+    class PerThread {
+    public:
+        PerThread() : slots_(max_threads()) {}
+        explicit PerThread(const T& init) : slots_(max_threads(), Slot{init}) {}
+
+        T& operator[](size_t thread) { return slots_[thread].value; }
+        const T& operator[](size_t thread) const { return slots_[thread].value; }
+        size_t size() const noexcept { return slots_.size(); }
+
+        template <typename F>
+        void for_each(F&& fn) {
+            for (auto& slot : slots_) fn(slot.value);
+        }
+
+    private:
+        struct alignas(64) Slot { T value; };
+        std::vector<Slot> slots_;
+    };
+}
@@ -5,9 +5,11 @@
 #include <cstddef>
 #include <random>
 #include <stdexcept>
+#include <memory>
 
 // Forward declaration for graph generators
 struct Graph;
+class ThreadPool;
 
 // Graph generation functions
 namespace GraphGenerator {
@@ -17,9 +19,36 @@ namespace GraphGenerator {
     Graph rmat(size_t scale, size_t E, float a = 0.57, float b = 0.19, float c = 0.19, unsigned seed = std::random_device{}());
 }
 
+// Degree-derived facts about a Graph that heuristics would otherwise rescan
+// for. Computed in parallel on first use, or adopted from a binary file or
+// from graph_stats(), which derives it in the same pass.
+// Left empty, and not symmetric, when the offsets are not a valid CSR.
+struct GraphMetadata {
+    // Hubs have at least HUB_DEGREE_FACTOR times the mean degree, and never fewer than HUB_MIN_DEGREE edges
+    static constexpr int HUB_MIN_DEGREE = 4096;
+    static constexpr int HUB_DEGREE_FACTOR = 16;
+    static constexpr size_t HISTOGRAM_BUCKETS = 33;  // Degree 0, then one per power of two up to 2^31
+
+    int max_degree = 0;
+    std::vector<size_t> degree_histogram;  // [0]: degree 0, [k]: degree in [2^(k-1), 2^k)
+    int hub_degree = 0;                    // Degree threshold for hubs
+    std::vector<int> hubs;                 // Ascending IDs of vertices with degree >= hub_degree
+    bool symmetric = false;                // Sorted lists, every u -> v matched by v -> u
+
+    static size_t degree_bucket(size_t degree) noexcept {
+        return degree == 0 ? 0 : 64 - __builtin_clzll(degree);
+    }
+    static int hub_threshold(size_t vertices, size_t edges);
+
+    // Everything but `symmetric` in O(V); the symmetry pass costs O(E log d)
+    static GraphMetadata degrees(const std::vector<int>& offsets, const std::vector<int>& edges);
+    static GraphMetadata compute(const std::vector<int>& offsets, const std::vector<int>& edges);
+};
+
 struct Graph {
     std::vector<int> offsets;
     std::vector<int> edges;
+    std::vector<float> weights;  // Optional, aligned with edges; empty for unweighted graphs
     const float avg_degree;
     
     Graph(std::vector<int>&& off, std::vector<int>&& e)
@@ -27,6 +56,19 @@ struct Graph {
           avg_degree(edges.size() / static_cast<float>(std::max<size_t>(1, offsets.size() - 1))) {
         if (offsets.size() < 2) throw std::invalid_argument("Graph must have at least 1 vertex");
     }
+
+    Graph(std::vector<int>&& off, std::vector<int>&& e, std::vector<float>&& w)
+        : Graph(std::move(off), std::move(e)) {
+        if (!w.empty() && w.size() != edges.size()) {
+            throw std::invalid_argument("Edge weights must align with edges");
+        }
+        weights = std::move(w);
+    }
+
+    // Computed on the first call and cached; safe to call from several threads
+    const GraphMetadata& metadata() const;
+    // Installs metadata already derived from these offsets and edges
+    void set_metadata(GraphMetadata meta);
     
     // Change this from implementation to declaration only:
     std::vector<int> neighbors(int u) const;
@@ -34,23 +76,38 @@ struct Graph {
     // Keep these inline implementations:
     size_t vertex_count() const noexcept { return offsets.size() - 1; }
     size_t edge_count() const noexcept { return edges.size(); }
+    bool weighted() const noexcept { return !weights.empty(); }
     
-    bool validate() const {
-        if (offsets.empty() || offsets.back() != edges.size()) return false;
-        for (int v : edges) {
-            if (v < 0 || v >= static_cast<int>(offsets.size() - 1)) return false;
-        }
-        return true;
-    }
+    // Offsets ascend from 0 to edge_count(), weights align and every target
+    // is in range; checked in parallel. graph_stats() says what is wrong.
+    bool validate() const;
+
+private:
+    mutable std::shared_ptr<const GraphMetadata> metadata_;  // Null until computed or installed
 };
 
 // Parallel BFS functions
 namespace ParallelBFS {
-    void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist);
+    // Frontier vertices the expansion loop prefetches ahead of the one it
+    // expands: offsets[] at this distance, the start of edges[] at half of it,
+    // and dist[] of neighbors one vertex (or this many edges) ahead. 0 disables.
+    constexpr int DEFAULT_PREFETCH_DISTANCE = 16;
+
+    void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist,
+                   int prefetch_distance = DEFAULT_PREFETCH_DISTANCE);
+    // Same traversal on a persistent pool: one run() for the whole BFS, levels separated by pool barriers
+    void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist, ThreadPool& pool,
+                   int prefetch_distance = DEFAULT_PREFETCH_DISTANCE);
     void baseline(const Graph& g, int source, std::vector<std::atomic<int>>& dist);
     
     // Utility functions
+    // Checks a BFS result against the BFS invariants in parallel, O(V + E),
+    // without rerunning a reference search: the source is at 0 and alone
+    // there, no edge out of a reached vertex lands more than one level deeper
+    // or on an unreached vertex, and every other reached vertex has an
+    // in-neighbor one level above. Prints the first violation to stderr.
     bool validate_result(const Graph& g, int source, const std::vector<std::atomic<int>>& dist);
+    bool validate_result(const Graph& g, int source, const std::vector<int>& dist);
     std::vector<int> get_distances(const std::vector<std::atomic<int>>& dist);
     void optimized_multi_source(const Graph& g, std::vector<std::atomic<int>>& dist);
 }
@@ -85,4 +142,12 @@ namespace GraphGenerator {
 
     Graph from_file(const std::string& filename);
 
+    // Binary CSR with its metadata, in native byte order: loading skips the
+    // text parsing, and the symmetry pass for graphs saved as not symmetric.
+    // from_binary runs Graph::validate() and rechecks the stored degree facts
+    // and hubs in O(V); a set symmetric flag is confirmed by the symmetry
+    // pass. Any mismatch throws std::runtime_error
+    void save_binary(const Graph& g, const std::string& filename);
+    Graph from_binary(const std::string& filename);
+
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <cstddef>
+#include <vector>
+
+namespace ParallelBFS {
+    enum class InitialSplit {
+        Block,   // Contiguous ID ranges with balanced edge counts
+        Degree   // Vertices dealt to parts in descending degree order
+    };
+
+    struct PartitionConfig {
+        int parts = 2;
+        InitialSplit initial = InitialSplit::Block;
+        int refinement_rounds = 20;   // Label-propagation rounds (0 = initial split only)
+        double max_imbalance = 1.05;  // Allowed max part edges over the mean
+    };
+
+    struct Partition {
+        std::vector<int> part;          // Owning partition of every vertex
+        std::vector<int> new_id;        // Partition-contiguous relabeling: old ID -> new ID
+        std::vector<int> part_offsets;  // New-ID range [part_offsets[p], part_offsets[p+1]) of each partition
+        std::vector<size_t> part_edges; // Out-edges owned by each partition
+        size_t edge_cut = 0;            // Edges whose endpoints sit in different partitions
+        double imbalance = 1.0;         // Max part_edges over the mean
+    };
+
+    // Splits the vertices into config.parts partitions with balanced edge
+    // counts, then refines with parallel label propagation that moves vertices
+    // to the partition holding most of their neighbors while capacity allows.
+    Partition partition(const Graph& g, const PartitionConfig& config = {});
+
+    // Returns g with vertex v renamed to new_id[v]. Throws std::invalid_argument
+    // unless new_id is a permutation of [0, V).
+    Graph relabel(const Graph& g, const std::vector<int>& new_id);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Word-level bitmap kernels behind the bottom-up BFS step. Every kernel has a
+// scalar version and, on x86, AVX2 and AVX-512 versions; the widest set the
+// CPU supports is picked on first use, so one binary runs on every machine.
+// BFS_SIMD=scalar|avx2|avx512 in the environment caps the choice.
+namespace Kernels {
+    // Instruction set the kernels resolved to: "avx512", "avx2" or "scalar"
+    const char* isa();
+
+    // Index of the first ids[i] whose bit is set in `bitmap`, or n if none.
+    // Bitmaps store vertex v at bit v % 64 of word v / 64.
+    size_t first_in_bitmap(const int* ids, size_t n, const uint64_t* bitmap);
+    // Same for 16-bit IDs, which fit twice as many per vector load
+    size_t first_in_bitmap(const uint16_t* ids, size_t n, const uint64_t* bitmap);
+
+    // Set bits in words [first_word, last_word)
+    size_t popcount(const uint64_t* words, size_t first_word, size_t last_word);
+
+    // Writes the index of every set bit in words [first_word, last_word) to
+    // `out` in ascending order and returns how many were written. `out` needs
+    // room for exactly popcount(words, first_word, last_word) entries.
+    size_t bitmap_to_list(const uint64_t* words, size_t first_word, size_t last_word, int* out);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "parallel_bfs.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ParallelBFS {
+    // Parallel delta-stepping single-source shortest paths over g.weights.
+    // Unreachable vertices are left at +infinity. A non-positive delta picks the
+    // mean edge weight. Unweighted and unit-weight graphs fall back to optimized().
+    // Throws std::invalid_argument on a negative, infinite or NaN weight.
+    void delta_stepping(const Graph& g, int source, std::vector<std::atomic<float>>& dist, float delta = 0.0f);
+
+    // True when the graph has no weights or every weight equals 1.
+    bool has_unit_weights(const Graph& g);
+
+    // Compact per-edge weights for dial_bfs, aligned with g.edges. Unweighted
+    // graphs map to all ones; throws if a weight is not an integer in [0, 255].
+    std::vector<uint8_t> small_integer_weights(const Graph& g);
+
+    // Dial-style bucketed BFS for small integer weights (0-1 BFS when every
+    // weight is 0 or 1). Keeps max_weight + 1 circular buckets of frontier
+    // lists; unreachable vertices are left at INT_MAX.
+    void dial_bfs(const Graph& g, const std::vector<uint8_t>& weights, int source, std::vector<std::atomic<int>>& dist);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker pool used as an alternative to OpenMP parallel regions.
+// Workers stay alive (spinning briefly, then sleeping) between jobs, so a
+// BFS can run every level inside one run() call and synchronize with the
+// pool barrier instead of forking and joining per level.
+class ThreadPool {
+public:
+    // Worker 0 is always the calling thread; `threads - 1` helpers are spawned.
+    // With `cpus` (e.g. from Topology::placement) worker w is pinned to cpus[w];
+    // the caller only for the duration of each run(), then gets its mask back.
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency(),
+                        const std::vector<int>& cpus = {});
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const noexcept { return workers_; }
+
+    // Runs fn(worker) once on every worker and returns when all are done.
+    void run(const std::function<void(size_t worker)>& fn);
+
+    // Level barrier across all workers. Only valid inside run().
+    void barrier();
+
+    // Collective loop over [0, n), only valid inside run() and called by every
+    // worker. Each worker seeds its own deque with `grain`-sized chunks of its
+    // static share, drains it from the back and steals from the front of the
+    // other deques once empty. Ends with a barrier.
+    void for_each(size_t worker, size_t n, size_t grain,
+                  const std::function<void(size_t begin, size_t end, size_t worker)>& fn);
+
+    // Standalone parallel loop: run() around a single for_each().
+    void parallel_for(size_t n, size_t grain,
+                      const std::function<void(size_t begin, size_t end, size_t worker)>& fn);
+
+private:
+    struct Range { size_t begin, end; };
+
+    struct alignas(64) WorkQueue {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        std::deque<Range> chunks;
+
+        bool pop_back(Range& out);
+        bool steal_front(Range& out);
+        void push_back(Range r);
+    };
+
+    void worker_loop(size_t worker);
+    void pin(size_t worker) const;
+
+    size_t workers_;
+    std::vector<int> cpus_;
+    std::vector<std::thread> threads_;
+    std::unique_ptr<WorkQueue[]> queues_;
+
+    // Job dispatch
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> generation_{0};
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> stop_{false};
+    const std::function<void(size_t)>* job_ = nullptr;
+
+    // Sense-reversing barrier
+    alignas(64) std::atomic<size_t> barrier_count_{0};
+    alignas(64) std::atomic<size_t> barrier_sense_{0};
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// CPU topology detection (Linux sysfs) and thread placement policies.
+namespace Topology {
+    struct Cpu {
+        int id;       // Logical CPU number
+        int core;     // Core ID, unique across packages
+        int package;  // Socket
+        int node;     // NUMA node
+    };
+
+    struct CpuTopology {
+        std::vector<Cpu> cpus;  // Online CPUs in this process's affinity mask
+        size_t cores = 0;
+        size_t packages = 0;
+        size_t nodes = 0;
+
+        size_t smt_per_core() const { return cores ? cpus.size() / cores : 1; }
+    };
+
+    enum class PinPolicy {
+        None,       // Leave placement to the OS / OpenMP runtime
+        Compact,    // Fill SMT siblings, then cores, then the next node
+        Scatter,    // Spread round-robin over nodes, one core each, SMT siblings last
+        OnePerCore  // First SMT sibling of every core only; wraps when threads > cores
+    };
+
+    // Reads /sys/devices/system/{cpu,node}; falls back to one flat node of
+    // hardware_concurrency() CPUs where sysfs is unavailable.
+    const CpuTopology& detect();
+
+    // CPU for each of `threads` workers under the policy (empty for None)
+    std::vector<int> placement(const CpuTopology& topology, PinPolicy policy, size_t threads);
+
+    // Binds the calling thread to one CPU; false if unsupported or refused
+    bool pin_current_thread(int cpu);
+
+    // The calling thread's allowed CPUs (empty if unsupported), and a way to
+    // put them back after pin_current_thread()
+    std::vector<int> current_affinity();
+    bool set_current_affinity(const std::vector<int>& cpus);
+
+    // Pins each worker of the parallel backend to its placement CPU, except
+    // thread 0: that is the calling thread, which keeps its own mask so that
+    // it, the processes it forks and the threads it starts later are not
+    // confined to one CPU. Call after Parallel::set_num_threads(); returns
+    // the placement, whose first CPU is left to the caller.
+    std::vector<int> pin_worker_threads(PinPolicy policy);
+
+    PinPolicy parse_policy(const std::string& name);  // Throws std::invalid_argument
+    const char* policy_name(PinPolicy policy);
+    std::string describe(const CpuTopology& topology);
+}
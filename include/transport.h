@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Message passing between the ranks of a distributed engine. Every call is
+// collective: all ranks make the same sequence of calls. The implementations
+// here connect processes on one machine, so the distributed engines can be
+// exercised without a cluster; a network transport only has to provide
+// exchange().
+namespace Distributed {
+    using Buffer = std::vector<uint8_t>;
+
+    class Transport {
+    public:
+        Transport(int rank, int size) : rank_(rank), size_(size) {}
+        virtual ~Transport() = default;
+
+        Transport(const Transport&) = delete;
+        Transport& operator=(const Transport&) = delete;
+
+        int rank() const noexcept { return rank_; }
+        int size() const noexcept { return size_; }
+
+        // Personalized all-to-all: out[r] is delivered to rank r, and the
+        // result holds what every rank addressed to this one (self included).
+        virtual std::vector<Buffer> exchange(std::vector<Buffer> out) = 0;
+
+        std::vector<std::vector<int>> exchange_ints(const std::vector<std::vector<int>>& out);
+        long long all_reduce_sum(long long value);
+        long long all_reduce_max(long long value);
+        void barrier();
+
+        // Payload bytes this rank has sent to other ranks
+        size_t bytes_sent() const noexcept { return bytes_sent_; }
+
+    protected:
+        void count_sent(const std::vector<Buffer>& out);
+
+    private:
+        std::vector<long long> all_gather(long long value);
+
+        int rank_;
+        int size_;
+        size_t bytes_sent_ = 0;
+    };
+
+    enum class TransportKind {
+        SharedMemory,  // Mailboxes in one shared mapping, process-shared barrier
+        Socket         // Full mesh of Unix-domain socket pairs
+    };
+
+    TransportKind parse_transport(const std::string& name);  // "shm" or "socket"; throws std::invalid_argument
+    const char* transport_name(TransportKind kind);
+
+    // Forks `ranks` processes on this machine, connects them with `kind` and
+    // runs body(transport) in each. Returns 0 when every rank returned 0;
+    // the remaining ranks are killed as soon as one fails. Ranks should not
+    // use the parallel backend: its worker threads do not survive fork().
+    int launch(int ranks, TransportKind kind, const std::function<int(Transport&)>& body);
+
+    // Anonymous shared mapping for handing results from the ranks back to
+    // the launching process: create it before launch(), write to it from a
+    // rank, read it once launch() has returned.
+    class SharedBuffer {
+    public:
+        explicit SharedBuffer(size_t bytes);
+        ~SharedBuffer();
+
+        SharedBuffer(const SharedBuffer&) = delete;
+        SharedBuffer& operator=(const SharedBuffer&) = delete;
+
+        uint8_t* data() const noexcept { return data_; }
+        size_t size() const noexcept { return size_; }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+}
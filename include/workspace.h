@@ -0,0 +1,67 @@
+#pragma once
+#include "frontier_bag.h"
+#include <cstddef>
+#include <vector>
+
+// Frontier and per-thread scratch buffers shared by the traversal engines.
+// A query leases a Workspace from a process-wide pool for its duration and
+// hands it back cleared but with its capacity intact, so every level after
+// the first, and every later query, appends into memory that is already
+// allocated and faulted in. Leases nest: an engine started from inside
+// another engine's query gets a workspace of its own.
+class Workspace {
+public:
+    class Lease {
+    public:
+        // Takes an idle workspace covering at least `threads` thread slots, or builds one
+        explicit Lease(size_t threads);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Workspace* operator->() const noexcept { return workspace_; }
+        Workspace& operator*() const noexcept { return *workspace_; }
+
+    private:
+        Workspace* workspace_;
+    };
+
+    explicit Workspace(size_t threads);
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    size_t threads() const noexcept { return slots_.size(); }
+
+    // Double-buffered frontiers indexed by level parity: frontier(level) is
+    // the one being expanded while frontier(level + 1) is filled
+    std::vector<int>& frontier(int level) noexcept { return frontiers_[level & 1]; }
+    FrontierBag& bag(int level) noexcept { return bags_[level & 1]; }
+
+    // Thread-private append buffer
+    std::vector<int>& local(size_t thread) noexcept { return slots_[thread].items; }
+    // Thread-private and shared per-bin lists for engines that scatter by vertex range
+    std::vector<std::vector<int>>& local_bins(size_t thread) noexcept { return slots_[thread].bins; }
+    std::vector<std::vector<int>>& bins() noexcept { return bins_; }
+
+    // Appends every local() buffer to `out` in thread order and empties them
+    void drain_locals(std::vector<int>& out);
+
+    // Frees the memory of every workspace not currently leased
+    static void release_idle();
+
+private:
+    struct alignas(64) Slot {
+        std::vector<int> items;
+        std::vector<std::vector<int>> bins;
+    };
+
+    // Empties every buffer, keeping capacity
+    void reset();
+
+    std::vector<int> frontiers_[2];
+    FrontierBag bags_[2];
+    std::vector<Slot> slots_;
+    std::vector<std::vector<int>> bins_;
+};
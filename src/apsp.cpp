@@ -0,0 +1,90 @@
+#include "apsp.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ParallelBFS {
+
+DistanceMatrix all_pairs_bfs(const Graph& g, size_t batch_width, size_t tile) {
+    if (batch_width < 64 || batch_width > 512 || batch_width % 64 != 0) {
+        throw std::invalid_argument("APSP batch width must be a multiple of 64 between 64 and 512");
+    }
+
+    const size_t V = g.vertex_count();
+    if (V > MAX_APSP_VERTICES) {
+        throw std::invalid_argument("APSP needs a " + std::to_string(V) + " x " + std::to_string(V) +
+                                    " matrix; graphs above " + std::to_string(MAX_APSP_VERTICES) + " vertices are rejected");
+    }
+    const size_t words = batch_width / 64;
+    const size_t batches = (V + batch_width - 1) / batch_width;
+
+    DistanceMatrix matrix;
+    matrix.n = V;
+    matrix.tile = tile;
+    const size_t padded = tile == 0 ? V : ((V + tile - 1) / tile) * tile;
+    matrix.data.assign(padded * padded, DistanceMatrix::UNREACHABLE);
+
+    // Per-thread bitsets: one bit per batch source for every vertex
+    struct Bitsets { std::vector<uint64_t> visited, frontier, next; };
+    Parallel::PerThread<Bitsets> scratch;
+
+    Parallel::for_chunks(batches, 1, [&](size_t batch_begin, size_t batch_end, size_t thread) {
+        Bitsets& bits = scratch[thread];
+        if (bits.visited.empty()) {
+            bits.visited.resize(V * words);
+            bits.frontier.resize(V * words);
+            bits.next.resize(V * words);
+        }
+        std::vector<uint64_t>& visited = bits.visited;
+        std::vector<uint64_t>& frontier = bits.frontier;
+        std::vector<uint64_t>& next = bits.next;
+
+        for (size_t b = batch_begin; b < batch_end; ++b) {
+            const size_t first = b * batch_width;
+            const size_t count = std::min(batch_width, V - first);
+
+            std::fill(visited.begin(), visited.end(), 0);
+            std::fill(frontier.begin(), frontier.end(), 0);
+            for (size_t i = 0; i < count; ++i) {
+                const size_t s = first + i;
+                frontier[s * words + i / 64] |= uint64_t(1) << (i % 64);
+                visited[s * words + i / 64] |= uint64_t(1) << (i % 64);
+                matrix.data[matrix.index(s, s)] = 0;
+            }
+
+            // Pulling over out-edges: bit i set at v in level L means d(v, first + i) == L
+            bool active = true;
+            for (int level = 1; active; ++level) {
+                active = false;
+                const uint8_t stored = static_cast<uint8_t>(std::min(level, DistanceMatrix::UNREACHABLE - 1));
+
+                for (size_t v = 0; v < V; ++v) {
+                    uint64_t* nv = &next[v * words];
+                    std::fill(nv, nv + words, 0);
+                    for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                        const uint64_t* fu = &frontier[static_cast<size_t>(g.edges[e]) * words];
+                        for (size_t w = 0; w < words; ++w) nv[w] |= fu[w];
+                    }
+
+                    uint64_t* seen = &visited[v * words];
+                    for (size_t w = 0; w < words; ++w) {
+                        uint64_t fresh = nv[w] & ~seen[w];
+                        nv[w] = fresh;
+                        seen[w] |= fresh;
+                        active |= (fresh != 0);
+                        while (fresh) {
+                            const size_t bit = __builtin_ctzll(fresh);
+                            matrix.data[matrix.index(v, first + w * 64 + bit)] = stored;
+                            fresh &= fresh - 1;
+                        }
+                    }
+                }
+                std::swap(frontier, next);
+            }
+        }
+    });
+    return matrix;
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,135 @@
+#include "async_bfs.h"
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace ParallelBFS {
+
+namespace {
+
+struct Item {
+    int vertex;
+    int dist;
+};
+
+// Per-worker bucketed queue; the owner and thieves share it under a spinlock
+struct alignas(64) BucketQueue {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    std::vector<std::vector<Item>> buckets;
+    size_t lowest = 0;
+    size_t size = 0;
+
+    void acquire() { while (lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield(); }
+    void release() { lock.clear(std::memory_order_release); }
+
+    void push(Item item, size_t bucket) {
+        acquire();
+        if (bucket >= buckets.size()) buckets.resize(bucket + 1);
+        buckets[bucket].push_back(item);
+        lowest = std::min(lowest, bucket);
+        size++;
+        release();
+    }
+
+    bool pop(Item& out) {
+        acquire();
+        bool found = size > 0;
+        if (found) {
+            while (buckets[lowest].empty()) lowest++;
+            out = buckets[lowest].back();
+            buckets[lowest].pop_back();
+            size--;
+        }
+        release();
+        return found;
+    }
+
+    // Moves up to half of the lowest bucket into `out`
+    size_t steal(std::vector<Item>& out, size_t& bucket) {
+        acquire();
+        size_t taken = 0;
+        if (size > 0) {
+            while (buckets[lowest].empty()) lowest++;
+            std::vector<Item>& src = buckets[lowest];
+            taken = (src.size() + 1) / 2;
+            out.assign(src.end() - taken, src.end());
+            src.resize(src.size() - taken);
+            size -= taken;
+            bucket = lowest;
+        }
+        release();
+        return taken;
+    }
+};
+
+} // namespace
+
+void async_bfs(const Graph& g, int source, std::vector<std::atomic<int>>& dist,
+               ThreadPool& pool, int bucket_width) {
+    if (bucket_width < 1) throw std::invalid_argument("Async BFS bucket width must be at least 1");
+    const size_t V = g.vertex_count();
+    const size_t T = pool.size();
+
+    std::unique_ptr<BucketQueue[]> queues(new BucketQueue[T]);
+    // Items pushed but not yet fully processed; zero means every queue has drained
+    std::atomic<size_t> pending{0};
+
+    auto bucket_of = [&](int d) -> size_t {
+        return static_cast<size_t>(d / bucket_width);
+    };
+
+    pool.run([&](size_t w) {
+        pool.for_each(w, V, 4096, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) dist[i].store(INT_MAX, std::memory_order_relaxed);
+        });
+        if (w == 0) {
+            dist[source].store(0);
+            pending.store(1);
+            queues[0].push({source, 0}, 0);
+        }
+        pool.barrier();
+
+        BucketQueue& mine = queues[w];
+        std::vector<Item> stolen;
+        Item item;
+
+        while (true) {
+            if (!mine.pop(item)) {
+                // Own queue empty: steal, or stop once nothing is pending anywhere
+                bool got = false;
+                for (size_t k = 1; k < T && !got; ++k) {
+                    size_t bucket;
+                    if (queues[(w + k) % T].steal(stolen, bucket) > 0) {
+                        for (const Item& s : stolen) mine.push(s, bucket);
+                        got = true;
+                    }
+                }
+                if (got) continue;
+                if (pending.load(std::memory_order_acquire) == 0) break;
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Skip entries superseded by a shorter distance found since the push
+            if (dist[item.vertex].load(std::memory_order_relaxed) == item.dist) {
+                const int nd = item.dist + 1;
+                for (int e = g.offsets[item.vertex]; e < g.offsets[item.vertex + 1]; ++e) {
+                    const int v = g.edges[e];
+                    int current = dist[v].load(std::memory_order_relaxed);
+                    while (nd < current) {
+                        if (dist[v].compare_exchange_weak(current, nd)) {
+                            pending.fetch_add(1, std::memory_order_relaxed);
+                            mine.push({v, nd}, bucket_of(nd));
+                            break;
+                        }
+                    }
+                }
+            }
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    });
+}
+
+} // namespace ParallelBFS
@@ -1,10 +1,12 @@
 #include "parallel_bfs.h"
+#include "topology.h"
+#include "parallel_backend.h"
+#include "simd_kernels.h"
 #include <chrono>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
-#include <omp.h>
 #include <climits>
 
 class Timer {
@@ -25,48 +27,53 @@ struct BenchmarkResult {
     double throughput_mega_edges_sec;
     double speedup;
     size_t reachable_vertices;
+    int prefetch_distance;
+    bool valid;
 };
 
 void run_benchmark(const Graph& g, const std::string& graph_name, 
-                  int num_threads, BenchmarkResult& result) {
+                  int num_threads, BenchmarkResult& result,
+                  int prefetch_distance = ParallelBFS::DEFAULT_PREFETCH_DISTANCE) {
     std::vector<std::atomic<int>> dist(g.vertex_count());
     
     // Warmup run
     {
         for (auto& d : dist) d.store(INT_MAX);
-        ParallelBFS::optimized(g, 0, dist);
+        ParallelBFS::optimized(g, 0, dist, prefetch_distance);
     }
 
     // Main benchmark
     const int runs = 5;
     double total_time = 0;
     size_t reachable = 0;
+    bool valid = false;
 
     for (int i = 0; i < runs; ++i) {
         // Reset distances
         for (auto& d : dist) d.store(INT_MAX);
         
         Timer timer;
-        ParallelBFS::optimized(g, 0, dist);
+        ParallelBFS::optimized(g, 0, dist, prefetch_distance);
         double elapsed = timer.elapsed();
         total_time += elapsed;
 
-        // Count reachable nodes only on first run
+        // Count reachable nodes and check the result only on first run
         if (i == 0) {
             reachable = std::count_if(dist.begin(), dist.end(),
                 [](const auto& d) { return d.load() != INT_MAX; });
+            valid = ParallelBFS::validate_result(g, 0, dist);
         }
     }
 
     // Calculate baseline (single-threaded) performance
     double baseline_time = 0;
     if (num_threads > 1) {
-        omp_set_num_threads(1);
+        Parallel::set_num_threads(1);
         for (auto& d : dist) d.store(INT_MAX);
         Timer timer;
-        ParallelBFS::optimized(g, 0, dist);
+        ParallelBFS::optimized(g, 0, dist, prefetch_distance);
         baseline_time = timer.elapsed();
-        omp_set_num_threads(num_threads);
+        Parallel::set_num_threads(num_threads);
     }
 
     // Store results
@@ -77,6 +84,8 @@ void run_benchmark(const Graph& g, const std::string& graph_name,
     result.throughput_mega_edges_sec = (g.edge_count() / (total_time / runs)) / 1e6;
     result.speedup = (num_threads > 1) ? (baseline_time / (total_time / runs)) : 1.0;
     result.reachable_vertices = reachable;
+    result.prefetch_distance = prefetch_distance;
+    result.valid = valid;
 }
 
 void print_results(const std::vector<BenchmarkResult>& results) {
@@ -88,6 +97,8 @@ void print_results(const std::vector<BenchmarkResult>& results) {
               << std::setw(15) << "Time (ms)"
               << std::setw(20) << "Throughput (M/s)"
               << std::setw(12) << "Speedup"
+              << std::setw(10) << "Prefetch"
+              << std::setw(8) << "Valid"
               << std::setw(15) << "Reachable"
               << "\n";
     
@@ -99,6 +110,8 @@ void print_results(const std::vector<BenchmarkResult>& results) {
                   << std::setw(15) << res.avg_time_sec * 1000
                   << std::setw(20) << res.throughput_mega_edges_sec
                   << std::setw(12) << res.speedup
+                  << std::setw(10) << res.prefetch_distance
+                  << std::setw(8) << (res.valid ? "yes" : "NO")
                   << std::setw(15) << res.reachable_vertices << " ("
                   << std::fixed << std::setprecision(1) 
                   << (100.0 * res.reachable_vertices / res.vertex_count) << "%)"
@@ -109,7 +122,7 @@ void print_results(const std::vector<BenchmarkResult>& results) {
 void save_results_to_csv(const std::vector<BenchmarkResult>& results, 
                         const std::string& filename) {
     std::ofstream out(filename);
-    out << "Graph,Vertices,Edges,Time(ms),Throughput(M/s),Speedup,Reachable,Reachable(%)\n";
+    out << "Graph,Vertices,Edges,Time(ms),Throughput(M/s),Speedup,Prefetch,Valid,Reachable,Reachable(%)\n";
     for (const auto& res : results) {
         out << res.graph_name << ","
             << res.vertex_count << ","
@@ -117,13 +130,15 @@ void save_results_to_csv(const std::vector<BenchmarkResult>& results,
             << res.avg_time_sec * 1000 << ","
             << res.throughput_mega_edges_sec << ","
             << res.speedup << ","
+            << res.prefetch_distance << ","
+            << (res.valid ? "yes" : "no") << ","
             << res.reachable_vertices << ","
             << (100.0 * res.reachable_vertices / res.vertex_count) << "\n";
     }
 }
 
-void thread_scaling_benchmark(const Graph& g, const std::string& graph_name) {
-    const int max_threads = omp_get_max_threads();
+void thread_scaling_benchmark(const Graph& g, const std::string& graph_name, Topology::PinPolicy pin) {
+    const int max_threads = static_cast<int>(Parallel::max_threads());
     std::vector<BenchmarkResult> scaling_results(max_threads);
 
     std::cout << "\nThread scaling for " << graph_name 
@@ -131,7 +146,8 @@ void thread_scaling_benchmark(const Graph& g, const std::string& graph_name) {
               << ", |E|=" << g.edge_count() << "):\n";
 
     for (int t = 1; t <= max_threads; ++t) {
-        omp_set_num_threads(t);
+        Parallel::set_num_threads(t);
+        Topology::pin_worker_threads(pin);
         run_benchmark(g, graph_name, t, scaling_results[t-1]);
     }
 
@@ -139,11 +155,39 @@ void thread_scaling_benchmark(const Graph& g, const std::string& graph_name) {
     save_results_to_csv(scaling_results, "scaling_" + graph_name + ".csv");
 }
 
+// Same BFS at several prefetch distances; 0 is the plain expansion loop
+void prefetch_benchmark(const Graph& g, const std::string& graph_name, int num_threads) {
+    std::vector<BenchmarkResult> prefetch_results;
+
+    std::cout << "\nPrefetch distance sweep for " << graph_name
+              << " (|V|=" << g.vertex_count()
+              << ", |E|=" << g.edge_count() << "):\n";
+
+    for (int distance : {0, 4, 8, 16, 32, 64}) {
+        BenchmarkResult res;
+        run_benchmark(g, graph_name, num_threads, res, distance);
+        prefetch_results.push_back(res);
+    }
+
+    print_results(prefetch_results);
+    save_results_to_csv(prefetch_results, "prefetch_" + graph_name + ".csv");
+}
+
 int main(int argc, char** argv) {
-    // Set default thread count to max available
-    const int num_threads = (argc > 1) ? std::stoi(argv[1]) : omp_get_max_threads();
-    omp_set_num_threads(num_threads);
-    std::cout << "Running benchmarks with " << num_threads << " threads\n";
+    // Usage: bfs_benchmark [threads] [pin policy] [prefetch distance]
+    const int num_threads = (argc > 1) ? std::stoi(argv[1]) : static_cast<int>(Parallel::max_threads());
+    const Topology::PinPolicy pin = (argc > 2) ? Topology::parse_policy(argv[2]) : Topology::PinPolicy::None;
+    const int prefetch_distance = (argc > 3) ? std::stoi(argv[3]) : ParallelBFS::DEFAULT_PREFETCH_DISTANCE;
+    Parallel::set_num_threads(num_threads);
+    std::cout << "Running benchmarks with " << num_threads << " threads ("
+              << Parallel::backend_name() << " backend, " << Kernels::isa() << " bitmap kernels)\n";
+
+    // Placement is fixed up front so repeated runs land on the same CPUs
+    std::cout << "Topology: " << Topology::describe(Topology::detect()) << "\n"
+              << "Placement: " << Topology::policy_name(pin);
+    for (int cpu : Topology::pin_worker_threads(pin)) std::cout << " " << cpu;
+    std::cout << "\n"
+              << "Prefetch distance: " << prefetch_distance << (prefetch_distance > 0 ? "" : " (off)") << "\n";
 
     // Generate test graphs
     std::vector<std::pair<std::string, Graph>> test_graphs;
@@ -159,12 +203,12 @@ int main(int argc, char** argv) {
         const Graph& graph = graph_pair.second;
         
         BenchmarkResult res;
-        run_benchmark(graph, name, num_threads, res);
+        run_benchmark(graph, name, num_threads, res, prefetch_distance);
         results.push_back(res);
         
         // Additional thread scaling analysis for the large graph
         if (name == "Huge R-MAT") {
-            thread_scaling_benchmark(graph, name);
+            thread_scaling_benchmark(graph, name, pin);
         }
     }
 
@@ -172,5 +216,9 @@ int main(int argc, char** argv) {
     print_results(results);
     save_results_to_csv(results, "bfs_benchmark_results.csv");
 
+    for (const auto& graph_pair : test_graphs) {
+        prefetch_benchmark(graph_pair.second, graph_pair.first, num_threads);
+    }
+
     return 0;
 }
\ No newline at end of file
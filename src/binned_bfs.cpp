@@ -0,0 +1,104 @@
+#include "binned_bfs.h"
+#include "parallel_backend.h"
+#include "workspace.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+namespace {
+
+// Streams the out-edges of frontier[begin, end) into per-bin lists. A
+// power-of-two bin width turns the per-edge division into a shift.
+template <bool PowerOfTwo>
+void scatter(const Graph& g, const std::vector<int>& frontier, size_t begin, size_t end,
+             const std::vector<uint64_t>& visited, size_t bin_vertices, int bin_shift,
+             std::vector<std::vector<int>>& bins) {
+    for (size_t i = begin; i < end; ++i) {
+        const int u = frontier[i];
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            const int v = g.edges[e];
+            if (visited[v / 64] & (uint64_t(1) << (v % 64))) continue;
+            if constexpr (PowerOfTwo) {
+                bins[static_cast<size_t>(v) >> bin_shift].push_back(v);
+            } else {
+                bins[static_cast<size_t>(v) / bin_vertices].push_back(v);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void binned_bfs(const Graph& g, int source, std::vector<std::atomic<int>>& dist, size_t bin_vertices) {
+    const size_t V = g.vertex_count();
+    if (source < 0 || static_cast<size_t>(source) >= V) throw std::out_of_range("Source vertex out of range");
+
+    if (bin_vertices == 0) bin_vertices = DEFAULT_BIN_VERTICES;
+    bin_vertices = (bin_vertices + 63) / 64 * 64;
+    const size_t bins = (V + bin_vertices - 1) / bin_vertices;
+    const int bin_shift = __builtin_ctzll(bin_vertices);
+    const bool power_of_two = (bin_vertices & (bin_vertices - 1)) == 0;
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        dist[i].store(INT_MAX, std::memory_order_relaxed);
+    });
+    dist[source].store(0);
+
+    // Read-only during binning, written per bin during apply: V / 8 bytes,
+    // small enough to filter revisits without touching dist
+    std::vector<uint64_t> visited((V + 63) / 64, 0);
+    visited[source / 64] |= uint64_t(1) << (source % 64);
+
+    Workspace::Lease workspace(Parallel::max_threads());
+    const size_t threads = workspace->threads();
+    std::vector<std::vector<int>>& bin_next = workspace->bins();
+    if (bin_next.size() < bins) bin_next.resize(bins);
+    std::vector<size_t> bin_start(bins);
+
+    std::vector<int>& frontier = workspace->frontier(0);
+    frontier.assign(1, source);
+    for (int level = 0; !frontier.empty(); ++level) {
+        // Phase 1: stream edges into per-thread, per-bin buffers
+        Parallel::for_chunks(frontier.size(), 64, [&](size_t begin, size_t end, size_t thread) {
+            std::vector<std::vector<int>>& mine = workspace->local_bins(thread);
+            if (mine.size() < bins) mine.resize(bins);
+            if (power_of_two) {
+                scatter<true>(g, frontier, begin, end, visited, bin_vertices, bin_shift, mine);
+            } else {
+                scatter<false>(g, frontier, begin, end, visited, bin_vertices, bin_shift, mine);
+            }
+        });
+
+        // Phase 2: each bin settles its own slice of dist and visited
+        Parallel::parallel_for(bins, [&](size_t b) {
+            std::vector<int>& next = bin_next[b];
+            next.clear();
+            for (size_t t = 0; t < threads; ++t) {
+                std::vector<std::vector<int>>& theirs = workspace->local_bins(t);
+                if (theirs.size() <= b) continue;
+                std::vector<int>& updates = theirs[b];
+                for (int v : updates) {
+                    uint64_t& word = visited[v / 64];
+                    const uint64_t bit = uint64_t(1) << (v % 64);
+                    if (word & bit) continue;
+                    word |= bit;
+                    dist[v].store(level + 1, std::memory_order_relaxed);
+                    next.push_back(v);
+                }
+                updates.clear();
+            }
+        }, 1);
+
+        // Concatenate in bin order, so the next frontier is grouped by vertex range
+        for (size_t b = 0; b < bins; ++b) bin_start[b] = bin_next[b].size();
+        frontier.resize(Parallel::exclusive_scan(bin_start));
+        Parallel::parallel_for(bins, [&](size_t b) {
+            std::copy(bin_next[b].begin(), bin_next[b].end(), frontier.begin() + bin_start[b]);
+        });
+    }
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,103 @@
+#include "bipartite.h"
+#include "frontier.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+namespace {
+
+// Joins the tree paths of the two endpoints of a same-parity edge into an odd cycle.
+std::vector<int> odd_cycle_from_edge(const std::vector<std::atomic<int>>& dist,
+                                     const std::vector<int>& parent, int u, int v) {
+    std::vector<int> up_u = {u};
+    std::vector<int> up_v = {v};
+    int a = u, b = v;
+
+    while (dist[a].load() > dist[b].load()) { a = parent[a]; up_u.push_back(a); }
+    while (dist[b].load() > dist[a].load()) { b = parent[b]; up_v.push_back(b); }
+    while (a != b) {
+        a = parent[a]; up_u.push_back(a);
+        b = parent[b]; up_v.push_back(b);
+    }
+
+    // up_u runs u -> lca, up_v runs v -> lca; drop the duplicated lca
+    up_v.pop_back();
+    up_u.insert(up_u.end(), up_v.rbegin(), up_v.rend());
+    return up_u;
+}
+
+} // namespace
+
+BipartiteResult bipartite(const Graph& g) {
+    const size_t V = g.vertex_count();
+    // On a directed graph the level parities say nothing about cycles
+    if (!g.metadata().symmetric) {
+        throw std::invalid_argument("Bipartiteness check needs a symmetric graph with sorted adjacency lists");
+    }
+
+    std::vector<std::atomic<int>> dist(V);
+    std::vector<int> parent(V, -1);
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        dist[i].store(INT_MAX, std::memory_order_relaxed);
+    });
+
+    std::atomic<bool> conflict{false};
+    int conflict_u = -1, conflict_v = -1;
+
+    Workspace::Lease workspace(Parallel::max_threads());
+    std::vector<int>& current_frontier = workspace->frontier(0);
+    std::vector<int>& next_frontier = workspace->frontier(1);
+
+    for (size_t s = 0; s < V && !conflict.load(); ++s) {
+        if (dist[s].load(std::memory_order_relaxed) != INT_MAX) continue;
+
+        dist[s].store(0, std::memory_order_relaxed);
+        parent[s] = static_cast<int>(s);
+        if (g.offsets[s] == g.offsets[s + 1]) continue;
+
+        current_frontier.assign(1, static_cast<int>(s));
+
+        while (!current_frontier.empty() && !conflict.load()) {
+            Frontier::expand(*workspace, current_frontier, next_frontier, [&](int u, std::vector<int>& out) {
+                if (conflict.load(std::memory_order_relaxed)) return;
+                const int du = dist[u].load(std::memory_order_relaxed);
+
+                for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    const int v = g.edges[e];
+                    int expected = INT_MAX;
+                    if (dist[v].compare_exchange_strong(expected, du + 1)) {
+                        parent[v] = u;
+                        out.push_back(v);
+                    } else if (((expected ^ du) & 1) == 0) {
+                        if (!conflict.exchange(true)) {
+                            conflict_u = u;
+                            conflict_v = v;
+                        }
+                        return;
+                    }
+                }
+            });
+            std::swap(current_frontier, next_frontier);
+        }
+    }
+
+    BipartiteResult result;
+    result.bipartite = !conflict.load();
+    if (!result.bipartite) {
+        result.odd_cycle = odd_cycle_from_edge(dist, parent, conflict_u, conflict_v);
+        return result;
+    }
+
+    result.color.resize(V);
+    Parallel::parallel_for(V, [&](size_t i) {
+        result.color[i] = dist[i].load(std::memory_order_relaxed) & 1;
+    });
+    return result;
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,102 @@
+#include "distance_stats.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+namespace ParallelBFS {
+
+DistanceHistogram distance_histogram(const Graph& g, size_t samples, unsigned seed) {
+    const size_t V = g.vertex_count();
+
+    std::vector<int> sources(V);
+    std::iota(sources.begin(), sources.end(), 0);
+    if (samples < V) {
+        // Partial Fisher-Yates: the first `samples` entries become a uniform distinct sample
+        std::mt19937 gen(seed);
+        for (size_t i = 0; i < samples; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, V - 1);
+            std::swap(sources[i], sources[pick(gen)]);
+        }
+        sources.resize(samples);
+    }
+
+    DistanceHistogram result;
+    result.samples = sources.size();
+
+    struct Scratch {
+        std::vector<size_t> counts;
+        std::vector<uint64_t> visited;
+        std::vector<int> current_frontier;
+        std::vector<int> next_frontier;
+    };
+    Parallel::PerThread<Scratch> scratch;
+
+    Parallel::for_chunks(sources.size(), 1, [&](size_t begin, size_t end, size_t thread) {
+        Scratch& local = scratch[thread];
+        std::vector<size_t>& local_counts = local.counts;
+        std::vector<uint64_t>& visited = local.visited;
+        std::vector<int>& current_frontier = local.current_frontier;
+        std::vector<int>& next_frontier = local.next_frontier;
+        if (visited.empty()) visited.resize((V + 63) / 64);
+
+        for (size_t i = begin; i < end; ++i) {
+            const int source = sources[i];
+            std::fill(visited.begin(), visited.end(), 0);
+            visited[source / 64] |= uint64_t(1) << (source % 64);
+            current_frontier.assign(1, source);
+
+            for (size_t level = 0; !current_frontier.empty(); ++level) {
+                if (local_counts.size() <= level) local_counts.resize(level + 1, 0);
+                local_counts[level] += current_frontier.size();
+
+                next_frontier.clear();
+                for (int u : current_frontier) {
+                    for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                        const int v = g.edges[e];
+                        const uint64_t bit = uint64_t(1) << (v % 64);
+                        if (!(visited[v / 64] & bit)) {
+                            visited[v / 64] |= bit;
+                            next_frontier.push_back(v);
+                        }
+                    }
+                }
+                std::swap(current_frontier, next_frontier);
+            }
+        }
+    });
+
+    scratch.for_each([&](const Scratch& local) {
+        if (result.level_counts.size() < local.counts.size()) {
+            result.level_counts.resize(local.counts.size(), 0);
+        }
+        for (size_t d = 0; d < local.counts.size(); ++d) {
+            result.level_counts[d] += local.counts[d];
+        }
+    });
+
+    double distance_sum = 0;
+    for (size_t d = 1; d < result.level_counts.size(); ++d) {
+        result.reachable_pairs += result.level_counts[d];
+        distance_sum += static_cast<double>(d) * result.level_counts[d];
+    }
+
+    if (result.reachable_pairs > 0) {
+        result.mean_distance = distance_sum / result.reachable_pairs;
+        size_t seen = 0;
+        for (size_t d = 1; d < result.level_counts.size(); ++d) {
+            seen += result.level_counts[d];
+            if (2 * seen >= result.reachable_pairs) {
+                result.median_distance = static_cast<int>(d);
+                break;
+            }
+        }
+    }
+    if (V > 1 && result.samples > 0) {
+        result.reachable_fraction = result.reachable_pairs / (static_cast<double>(result.samples) * (V - 1));
+    }
+    return result;
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,308 @@
+#include "distributed_bfs.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+namespace {
+
+// Contiguous ranges with balanced edge counts: part p owns [bounds[p], bounds[p + 1])
+std::vector<int> balanced_bounds(const Graph& g, int parts) {
+    const size_t V = g.vertex_count();
+    const size_t E = g.edge_count();
+    std::vector<int> bounds(parts + 1, 0);
+    for (int p = 1; p < parts; ++p) {
+        const int target = static_cast<int>(E * p / parts);
+        auto it = std::lower_bound(g.offsets.begin(), g.offsets.end() - 1, target);
+        bounds[p] = std::max(bounds[p - 1], static_cast<int>(it - g.offsets.begin()));
+    }
+    bounds[parts] = static_cast<int>(V);
+    return bounds;
+}
+
+int owner_of(const std::vector<int>& bounds, int v) {
+    return static_cast<int>(std::upper_bound(bounds.begin() + 1, bounds.end() - 1, v) - (bounds.begin() + 1));
+}
+
+// Collects every rank's owned range of dist into one array on rank 0
+std::vector<int> gather_on_root(std::vector<int> local, const std::vector<int>& bounds, Distributed::Transport& transport) {
+    std::vector<std::vector<int>> gather(transport.size());
+    gather[0] = std::move(local);
+    std::vector<std::vector<int>> slices = transport.exchange_ints(gather);
+
+    std::vector<int> dist;
+    if (transport.rank() == 0) {
+        dist.resize(bounds.back());
+        for (int r = 0; r < transport.size(); ++r) std::copy(slices[r].begin(), slices[r].end(), dist.begin() + bounds[r]);
+    }
+    return dist;
+}
+
+// Vertex sets on the wire. A sorted set within [lo, hi) goes out as a tag
+// byte followed by either a bitmap of the range or the varint-coded gaps
+// between consecutive IDs, whichever is shorter. Dense frontiers cost
+// (hi - lo) / 8 bytes, sparse ones one or two bytes per vertex.
+enum : uint8_t { SET_GAPS = 0, SET_BITMAP = 1 };
+
+size_t varint_size(uint32_t x) {
+    size_t n = 1;
+    for (; x >= 0x80; x >>= 7) ++n;
+    return n;
+}
+
+Distributed::Buffer encode_set(const std::vector<int>& sorted, int lo, int hi) {
+    Distributed::Buffer out;
+    if (sorted.empty()) return out;
+
+    size_t gap_bytes = 0;
+    int prev = lo;
+    for (int v : sorted) {
+        gap_bytes += varint_size(static_cast<uint32_t>(v - prev));
+        prev = v;
+    }
+    const size_t bitmap_bytes = (static_cast<size_t>(hi - lo) + 7) / 8;
+
+    if (bitmap_bytes < gap_bytes) {
+        out.assign(1 + bitmap_bytes, 0);
+        out[0] = SET_BITMAP;
+        for (int v : sorted) out[1 + (v - lo) / 8] |= uint8_t(1) << ((v - lo) % 8);
+    } else {
+        out.reserve(1 + gap_bytes);
+        out.push_back(SET_GAPS);
+        prev = lo;
+        for (int v : sorted) {
+            uint32_t x = static_cast<uint32_t>(v - prev);
+            for (; x >= 0x80; x >>= 7) out.push_back(static_cast<uint8_t>(x | 0x80));
+            out.push_back(static_cast<uint8_t>(x));
+            prev = v;
+        }
+    }
+    return out;
+}
+
+// Appends the set in ascending order
+void decode_set(const Distributed::Buffer& in, int lo, std::vector<int>& out) {
+    if (in.empty()) return;
+    if (in[0] == SET_BITMAP) {
+        for (size_t i = 1; i < in.size(); ++i) {
+            for (unsigned bits = in[i]; bits; bits &= bits - 1) {
+                out.push_back(lo + static_cast<int>((i - 1) * 8) + __builtin_ctz(bits));
+            }
+        }
+        return;
+    }
+
+    int v = lo;
+    uint32_t x = 0;
+    int shift = 0;
+    for (size_t i = 1; i < in.size(); ++i) {
+        x |= static_cast<uint32_t>(in[i] & 0x7f) << shift;
+        if (in[i] & 0x80) {
+            shift += 7;
+            continue;
+        }
+        v += static_cast<int>(x);
+        out.push_back(v);
+        x = 0;
+        shift = 0;
+    }
+}
+
+} // namespace
+
+DistributedResult distributed_bfs(const Graph& g, int source, Distributed::Transport& transport) {
+    const size_t V = g.vertex_count();
+    const int P = transport.size();
+    const int me = transport.rank();
+    if (source < 0 || static_cast<size_t>(source) >= V) throw std::out_of_range("Source vertex out of range");
+
+    const std::vector<int> bounds = balanced_bounds(g, P);
+    const int first = bounds[me];
+    const int last = bounds[me + 1];
+
+    // This rank's CSR slice, neighbor IDs stay global
+    const int base = g.offsets[first];
+    std::vector<int> offsets(last - first + 1);
+    for (int v = first; v <= last; ++v) offsets[v - first] = g.offsets[v] - base;
+    std::vector<int> edges(g.edges.begin() + base, g.edges.begin() + g.offsets[last]);
+
+    std::vector<int> dist(last - first, INT_MAX);
+    std::vector<uint64_t> forwarded((V + 63) / 64, 0);
+    std::vector<int> frontier, next;
+    if (source >= first && source < last) {
+        dist[source - first] = 0;
+        frontier.push_back(source);
+    }
+
+    auto settle = [&](int v, int level) {
+        if (dist[v - first] == INT_MAX) {
+            dist[v - first] = level;
+            next.push_back(v);
+        }
+    };
+
+    DistributedResult result;
+    std::vector<std::vector<int>> outgoing(P);
+    const size_t bytes_before = transport.bytes_sent();
+    transport.barrier();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int level = 0; ; ++level) {
+        next.clear();
+        for (auto& box : outgoing) box.clear();
+
+        for (int u : frontier) {
+            for (int e = offsets[u - first]; e < offsets[u - first + 1]; ++e) {
+                const int v = edges[e];
+                if (v >= first && v < last) {
+                    settle(v, level + 1);
+                } else if (!(forwarded[v / 64] & (uint64_t(1) << (v % 64)))) {
+                    forwarded[v / 64] |= uint64_t(1) << (v % 64);
+                    outgoing[owner_of(bounds, v)].push_back(v);
+                }
+            }
+        }
+
+        for (const std::vector<int>& incoming : transport.exchange_ints(outgoing)) {
+            for (int v : incoming) settle(v, level + 1);
+        }
+
+        std::swap(frontier, next);
+        result.levels = level + 1;
+        if (transport.all_reduce_sum(static_cast<long long>(frontier.size())) == 0) break;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    result.seconds = transport.all_reduce_max(elapsed.count()) / 1e6;
+    result.bytes_sent = static_cast<size_t>(transport.all_reduce_sum(static_cast<long long>(transport.bytes_sent() - bytes_before)));
+
+    result.dist = gather_on_root(std::move(dist), bounds, transport);
+    return result;
+}
+
+std::pair<int, int> grid_shape(int ranks) {
+    int rows = 1;
+    for (int r = 1; r * r <= ranks; ++r) {
+        if (ranks % r == 0) rows = r;
+    }
+    return {rows, ranks / rows};
+}
+
+DistributedResult distributed_bfs_2d(const Graph& g, int source, Distributed::Transport& transport) {
+    const size_t V = g.vertex_count();
+    const int P = transport.size();
+    const int me = transport.rank();
+    if (source < 0 || static_cast<size_t>(source) >= V) throw std::out_of_range("Source vertex out of range");
+
+    const std::pair<int, int> grid = grid_shape(P);
+    const int C = grid.second;
+    const int row = me / C;
+    const int col = me % C;
+
+    // Block k belongs to rank k. Processor row i owns blocks i*C .. i*C + C - 1,
+    // one contiguous destination range; processor column j owns blocks j, j + C, ...
+    const std::vector<int> bounds = balanced_bounds(g, P);
+    const int first = bounds[me];
+    const int last = bounds[me + 1];
+    const int row_first = bounds[row * C];
+    const int row_last = bounds[row * C + C];
+
+    // Local index of each column block's first vertex within the column strip
+    std::vector<int> strip_base(P, -1);
+    int strip_size = 0;
+    for (int k = col; k < P; k += C) {
+        strip_base[k] = strip_size;
+        strip_size += bounds[k + 1] - bounds[k];
+    }
+
+    // Edges u -> v with u in this column's strip and v in this row's range
+    std::vector<int> offsets(strip_size + 1);
+    std::vector<int> edges;
+    for (int k = col; k < P; k += C) {
+        for (int u = bounds[k]; u < bounds[k + 1]; ++u) {
+            offsets[strip_base[k] + u - bounds[k]] = static_cast<int>(edges.size());
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const int v = g.edges[e];
+                if (v >= row_first && v < row_last) edges.push_back(v);
+            }
+        }
+    }
+    offsets[strip_size] = static_cast<int>(edges.size());
+
+    std::vector<int> dist(last - first, INT_MAX);
+    std::vector<uint64_t> folded((row_last - row_first + 63) / 64, 0);
+    std::vector<int> frontier, next, received;
+    if (source >= first && source < last) {
+        dist[source - first] = 0;
+        frontier.push_back(source);
+    }
+
+    DistributedResult result;
+    std::vector<std::vector<int>> outgoing(P);
+    const size_t bytes_before = transport.bytes_sent();
+    transport.barrier();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int level = 0; ; ++level) {
+        // Expand: share this block's frontier with the rest of the processor column
+        std::vector<Distributed::Buffer> out(P);
+        const Distributed::Buffer mine = encode_set(frontier, first, last);
+        for (int i = 0; i < P / C; ++i) out[i * C + col] = mine;
+        std::vector<Distributed::Buffer> in = transport.exchange(std::move(out));
+
+        for (auto& box : outgoing) box.clear();
+        for (int k = col; k < P; k += C) {
+            received.clear();
+            decode_set(in[k], bounds[k], received);
+            for (int u : received) {
+                const int local = strip_base[k] + u - bounds[k];
+                for (int e = offsets[local]; e < offsets[local + 1]; ++e) {
+                    const int v = edges[e];
+                    uint64_t& word = folded[(v - row_first) / 64];
+                    const uint64_t bit = uint64_t(1) << ((v - row_first) % 64);
+                    if (word & bit) continue;
+                    word |= bit;
+                    outgoing[owner_of(bounds, v)].push_back(v);
+                }
+            }
+        }
+
+        // Fold: hand each discovery to its owner within the processor row
+        out.assign(P, Distributed::Buffer());
+        for (int j = 0; j < C; ++j) {
+            const int owner = row * C + j;
+            std::sort(outgoing[owner].begin(), outgoing[owner].end());
+            out[owner] = encode_set(outgoing[owner], bounds[owner], bounds[owner + 1]);
+        }
+        in = transport.exchange(std::move(out));
+
+        next.clear();
+        for (int j = 0; j < C; ++j) {
+            received.clear();
+            decode_set(in[row * C + j], first, received);
+            for (int v : received) {
+                if (dist[v - first] == INT_MAX) {
+                    dist[v - first] = level + 1;
+                    next.push_back(v);
+                }
+            }
+        }
+        std::sort(next.begin(), next.end());
+
+        std::swap(frontier, next);
+        result.levels = level + 1;
+        if (transport.all_reduce_sum(static_cast<long long>(frontier.size())) == 0) break;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    result.seconds = transport.all_reduce_max(elapsed.count()) / 1e6;
+    result.bytes_sent = static_cast<size_t>(transport.all_reduce_sum(static_cast<long long>(transport.bytes_sent() - bytes_before)));
+
+    result.dist = gather_on_root(std::move(dist), bounds, transport);
+    return result;
+}
+
+} // namespace ParallelBFS
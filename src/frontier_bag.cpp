@@ -0,0 +1,55 @@
+#include "frontier_bag.h"
+#include <algorithm>
+
+FrontierBag::FrontierBag(size_t threads) : slots_(std::max<size_t>(1, threads)) {}
+
+FrontierBag::~FrontierBag() {
+    for (auto& slot : slots_) {
+        for (Chunk* chunk : slot.owned) delete chunk;
+    }
+}
+
+FrontierBag::Chunk* FrontierBag::acquire(size_t thread) {
+    Slot& slot = slots_[thread];
+    Chunk* chunk;
+    if (!slot.free.empty()) {
+        chunk = slot.free.back();
+        slot.free.pop_back();
+    } else {
+        chunk = new Chunk;
+        slot.owned.push_back(chunk);
+    }
+    chunk->size = 0;
+    chunk->next = nullptr;
+    return chunk;
+}
+
+void FrontierBag::seal() {
+    for (auto& slot : slots_) {
+        if (slot.open == nullptr) continue;
+        if (slot.open->size > 0) {
+            publish(slot.open);
+        } else {
+            slot.free.push_back(slot.open);
+        }
+        slot.open = nullptr;
+    }
+
+    for (Chunk* chunk = published_.exchange(nullptr, std::memory_order_acquire); chunk != nullptr; chunk = chunk->next) {
+        sealed_.push_back(chunk);
+        size_ += chunk->size;
+        for (size_t i = 0; i < chunk->size; i += SPLIT_SIZE) {
+            ranges_.push_back({chunk->items + i, chunk->items + std::min(i + SPLIT_SIZE, chunk->size)});
+        }
+    }
+}
+
+void FrontierBag::clear() {
+    // Any slot may take the chunk back: ownership only matters for deletion
+    for (size_t i = 0; i < sealed_.size(); ++i) {
+        slots_[i % slots_.size()].free.push_back(sealed_[i]);
+    }
+    sealed_.clear();
+    ranges_.clear();
+    size_ = 0;
+}
@@ -0,0 +1,187 @@
+#include "graph_stats.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace ParallelBFS {
+
+namespace {
+
+constexpr size_t HISTOGRAM_BUCKETS = GraphMetadata::HISTOGRAM_BUCKETS;
+
+// Bucket label: "0", "1", "2-3", "4-7", ...
+void print_bucket(std::ostream& out, size_t k) {
+    if (k <= 1) {
+        out << k;
+        return;
+    }
+    out << (size_t(1) << (k - 1)) << "-" << ((size_t(1) << k) - 1);
+}
+
+} // namespace
+
+GraphStats graph_stats(const Graph& g) {
+    const size_t V = g.vertex_count();
+    const size_t E = g.edge_count();
+    const int* offsets = g.offsets.data();
+    const int* edges = g.edges.data();
+
+    const size_t bad_offsets = Parallel::sum<size_t>(V, [&](size_t u) {
+        return offsets[u] > offsets[u + 1] ? 1 : 0;
+    }, 4096);
+    if (offsets[0] != 0 || static_cast<size_t>(offsets[V]) != E || bad_offsets > 0) {
+        throw std::invalid_argument("Graph offsets are not a CSR over its " + std::to_string(E) + " edges");
+    }
+
+    GraphStats stats;
+    stats.vertices = V;
+    stats.edges = E;
+    stats.mean_degree = static_cast<double>(E) / V;
+
+    const size_t words = (V + 63) / 64;
+    std::vector<std::atomic<uint64_t>> has_in(words);
+    Parallel::parallel_for(words, [&](size_t w) { has_in[w].store(0, std::memory_order_relaxed); });
+    std::vector<uint8_t> sorted(V);
+
+    struct Partial {
+        size_t min_degree = SIZE_MAX;
+        size_t max_degree = 0;
+        size_t self_loops = 0;
+        size_t duplicates = 0;
+        size_t invalid = 0;
+        size_t unsorted = 0;
+        size_t isolated = 0;
+        size_t reciprocated = 0;
+        std::array<size_t, HISTOGRAM_BUCKETS> histogram{};
+        std::vector<int> hubs;
+    };
+    const int hub_degree = GraphMetadata::hub_threshold(V, E);
+    Parallel::PerThread<Partial> partials;
+
+    // Pass 1: degrees, targets, list order and in-edge marks
+    Parallel::for_chunks(V, 256, [&](size_t begin, size_t end, size_t thread) {
+        Partial& p = partials[thread];
+        for (size_t u = begin; u < end; ++u) {
+            const size_t degree = offsets[u + 1] - offsets[u];
+            p.min_degree = std::min(p.min_degree, degree);
+            p.max_degree = std::max(p.max_degree, degree);
+            p.histogram[GraphMetadata::degree_bucket(degree)]++;
+            if (degree >= static_cast<size_t>(hub_degree)) p.hubs.push_back(static_cast<int>(u));
+
+            bool ascending = true;
+            size_t repeats = 0;
+            long long prev = -1;
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                const int v = edges[e];
+                if (v < 0 || static_cast<size_t>(v) >= V) {
+                    p.invalid++;
+                    continue;
+                }
+                if (static_cast<size_t>(v) == u) p.self_loops++;
+                if (v < prev) ascending = false;
+                if (v == prev) repeats++;
+                prev = v;
+
+                std::atomic<uint64_t>& word = has_in[v / 64];
+                const uint64_t bit = uint64_t(1) << (v % 64);
+                if (!(word.load(std::memory_order_relaxed) & bit)) word.fetch_or(bit, std::memory_order_relaxed);
+            }
+
+            // An unsorted list's duplicates are counted once it is sorted below
+            if (ascending) p.duplicates += repeats;
+            else p.unsorted++;
+            sorted[u] = ascending;
+        }
+    });
+
+    // Reverse edges are looked up by binary search, so unsorted lists are
+    // sorted in a scratch copy rather than scanned linearly per lookup
+    std::vector<int> sorted_edges;
+    const size_t unsorted = Parallel::sum<size_t>(V, [&](size_t u) { return sorted[u] ? 0 : 1; }, 4096);
+    if (unsorted > 0) {
+        sorted_edges.assign(g.edges.begin(), g.edges.end());
+        Parallel::for_chunks(V, 256, [&](size_t begin, size_t end, size_t thread) {
+            Partial& p = partials[thread];
+            for (size_t u = begin; u < end; ++u) {
+                if (sorted[u]) continue;
+                int* first = sorted_edges.data() + offsets[u];
+                int* last = sorted_edges.data() + offsets[u + 1];
+                std::sort(first, last);
+                for (const int* it = first + 1; it < last; ++it) {
+                    p.duplicates += *it == it[-1] && *it >= 0 && static_cast<size_t>(*it) < V;
+                }
+            }
+        });
+        edges = sorted_edges.data();
+    }
+
+    // Pass 2: isolation and reverse edges
+    Parallel::for_chunks(V, 256, [&](size_t begin, size_t end, size_t thread) {
+        Partial& p = partials[thread];
+        for (size_t u = begin; u < end; ++u) {
+            if (offsets[u] == offsets[u + 1] && !(has_in[u / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (u % 64)))) {
+                p.isolated++;
+            }
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                const int v = edges[e];
+                if (v < 0 || static_cast<size_t>(v) >= V || static_cast<size_t>(v) == u) continue;
+                const int* first = edges + offsets[v];
+                const int* last = edges + offsets[v + 1];
+                p.reciprocated += std::binary_search(first, last, static_cast<int>(u));
+            }
+        }
+    });
+
+    std::array<size_t, HISTOGRAM_BUCKETS> histogram{};
+    std::vector<int>& hubs = stats.metadata.hubs;
+    stats.min_degree = SIZE_MAX;
+    partials.for_each([&](const Partial& p) {
+        stats.min_degree = std::min(stats.min_degree, p.min_degree);
+        stats.max_degree = std::max(stats.max_degree, p.max_degree);
+        stats.self_loops += p.self_loops;
+        stats.duplicate_edges += p.duplicates;
+        stats.invalid_targets += p.invalid;
+        stats.unsorted_lists += p.unsorted;
+        stats.isolated += p.isolated;
+        stats.reciprocated += p.reciprocated;
+        for (size_t k = 0; k < HISTOGRAM_BUCKETS; ++k) histogram[k] += p.histogram[k];
+        hubs.insert(hubs.end(), p.hubs.begin(), p.hubs.end());
+    });
+    std::sort(hubs.begin(), hubs.end());
+
+    stats.degree_histogram.assign(histogram.begin(), histogram.begin() + GraphMetadata::degree_bucket(stats.max_degree) + 1);
+    const size_t checked = E - stats.invalid_targets - stats.self_loops;
+    stats.symmetry_ratio = checked == 0 ? 1.0 : static_cast<double>(stats.reciprocated) / checked;
+
+    stats.metadata.max_degree = static_cast<int>(stats.max_degree);
+    stats.metadata.degree_histogram = stats.degree_histogram;
+    stats.metadata.hub_degree = hub_degree;
+    // As GraphMetadata::compute has it: valid, sorted and every edge mirrored
+    stats.metadata.symmetric = stats.invalid_targets == 0 && stats.unsorted_lists == 0 && stats.reciprocated == checked;
+    return stats;
+}
+
+void print_graph_stats(const GraphStats& stats, std::ostream& out) {
+    out << "  Degree:   min " << stats.min_degree << ", max " << stats.max_degree
+        << ", mean " << stats.mean_degree << "\n"
+        << "  Histogram:";
+    for (size_t k = 0; k < stats.degree_histogram.size(); ++k) {
+        if (stats.degree_histogram[k] == 0) continue;
+        out << " ";
+        print_bucket(out, k);
+        out << ":" << stats.degree_histogram[k];
+    }
+    out << "\n"
+        << "  Isolated: " << stats.isolated << " vertices\n"
+        << "  Symmetry: " << stats.symmetry_ratio << " (" << stats.reciprocated << " edges reciprocated)\n";
+    if (stats.self_loops > 0) out << "  Warning: " << stats.self_loops << " self-loops\n";
+    if (stats.duplicate_edges > 0) out << "  Warning: " << stats.duplicate_edges << " duplicate edges\n";
+    if (stats.unsorted_lists > 0) out << "  Warning: " << stats.unsorted_lists << " unsorted adjacency lists\n";
+    if (stats.invalid_targets > 0) out << "  Warning: " << stats.invalid_targets << " edge targets out of range\n";
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,244 @@
+#include "hybrid_bfs.h"
+#include "frontier.h"
+#include "parallel_backend.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ParallelBFS {
+
+namespace {
+
+// Bitmap words handled per parallel chunk (4096 vertices)
+constexpr size_t BLOCK_WORDS = 64;
+
+// Largest vertex count whose IDs fit the 16-bit instantiations
+constexpr size_t NARROW_VERTICES = size_t(1) << 16;
+
+} // namespace
+
+HybridBFS::HybridBFS(const Graph& g, double alpha, double beta) : g_(g), alpha_(alpha), beta_(beta) {
+    if (alpha <= 0 || beta <= 0) throw std::invalid_argument("Direction switch thresholds must be positive");
+
+    const size_t V = g.vertex_count();
+
+    // A symmetric graph is its own transpose
+    if (!g.metadata().symmetric) {
+        std::vector<std::atomic<int>> cursor(V);
+        Parallel::parallel_for(V, [&](size_t v) { cursor[v].store(0, std::memory_order_relaxed); });
+        Parallel::parallel_for(V, [&](size_t u) {
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                cursor[g.edges[e]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }, 1024);
+
+        in_offsets_.assign(V + 1, 0);
+        for (size_t v = 0; v < V; ++v) {
+            in_offsets_[v + 1] = in_offsets_[v] + cursor[v].load(std::memory_order_relaxed);
+            cursor[v].store(in_offsets_[v], std::memory_order_relaxed);
+        }
+
+        in_edges_.resize(g.edge_count());
+        Parallel::parallel_for(V, [&](size_t u) {
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                in_edges_[cursor[g.edges[e]].fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(u);
+            }
+        }, 1024);
+        // Sorted in-lists scan the frontier bitmap in address order
+        Parallel::parallel_for(V, [&](size_t v) {
+            std::sort(in_edges_.begin() + in_offsets_[v], in_edges_.begin() + in_offsets_[v + 1]);
+        }, 1024);
+    }
+
+    narrow_ = V <= NARROW_VERTICES;
+    if (narrow_) {
+        const std::vector<int>& lists = symmetric() ? g.edges : in_edges_;
+        narrow_in_edges_.resize(lists.size());
+        Parallel::parallel_for(lists.size(), [&](size_t e) {
+            narrow_in_edges_[e] = static_cast<uint16_t>(lists[e]);
+        });
+        std::vector<int>().swap(in_edges_);
+    }
+
+    const size_t words = (V + 63) / 64;
+    front_.assign(words, 0);
+    next_.assign(words, 0);
+    visited_.assign(words, 0);
+}
+
+template <typename Id, bool Symmetric>
+size_t HybridBFS::bottom_up_step(int level, std::vector<std::atomic<int>>& dist) {
+    const size_t V = g_.vertex_count();
+    const size_t words = front_.size();
+    const size_t blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+    // A symmetric graph scans its own lists; otherwise the transpose built in the constructor
+    const int* offsets;
+    if constexpr (Symmetric) {
+        offsets = g_.offsets.data();
+    } else {
+        offsets = in_offsets_.data();
+    }
+    const Id* lists;
+    if constexpr (std::is_same<Id, uint16_t>::value) {
+        lists = narrow_in_edges_.data();
+    } else if constexpr (Symmetric) {
+        lists = g_.edges.data();
+    } else {
+        lists = in_edges_.data();
+    }
+
+    // Each chunk owns whole bitmap words, so next_/visited_ need no atomics
+    return Parallel::sum<size_t>(blocks, [&](size_t b) {
+        const size_t first = b * BLOCK_WORDS;
+        const size_t last = std::min(words, first + BLOCK_WORDS);
+
+        for (size_t w = first; w < last; ++w) {
+            uint64_t unvisited = ~visited_[w];
+            if (w == words - 1 && V % 64 != 0) unvisited &= (uint64_t(1) << (V % 64)) - 1;
+
+            uint64_t found = 0;
+            while (unvisited) {
+                const int bit = __builtin_ctzll(unvisited);
+                unvisited &= unvisited - 1;
+
+                const int v = static_cast<int>(w * 64 + bit);
+                const size_t n = offsets[v + 1] - offsets[v];
+                if (Kernels::first_in_bitmap(lists + offsets[v], n, front_.data()) < n) {
+                    found |= uint64_t(1) << bit;
+                    dist[v].store(level + 1, std::memory_order_relaxed);
+                }
+            }
+            next_[w] = found;
+            visited_[w] |= found;
+        }
+        return Kernels::popcount(next_.data(), first, last);
+    }, 1);
+}
+
+void HybridBFS::bitmap_to_frontier(std::vector<int>& frontier) const {
+    const size_t words = front_.size();
+    const size_t blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+    std::vector<size_t> start(blocks);
+    Parallel::parallel_for(blocks, [&](size_t b) {
+        start[b] = Kernels::popcount(front_.data(), b * BLOCK_WORDS, std::min(words, (b + 1) * BLOCK_WORDS));
+    });
+    frontier.resize(Parallel::exclusive_scan(start));
+    Parallel::parallel_for(blocks, [&](size_t b) {
+        Kernels::bitmap_to_list(front_.data(), b * BLOCK_WORDS, std::min(words, (b + 1) * BLOCK_WORDS),
+                                frontier.data() + start[b]);
+    });
+}
+
+void HybridBFS::run(int source, std::vector<std::atomic<int>>& dist) {
+    const size_t V = g_.vertex_count();
+    if (source < 0 || static_cast<size_t>(source) >= V) throw std::out_of_range("Source vertex out of range");
+
+    if (narrow_) {
+        symmetric() ? run_as<uint16_t, true>(source, dist) : run_as<uint16_t, false>(source, dist);
+    } else {
+        symmetric() ? run_as<int, true>(source, dist) : run_as<int, false>(source, dist);
+    }
+}
+
+template <typename Id, bool Symmetric>
+void HybridBFS::run_as(int source, std::vector<std::atomic<int>>& dist) {
+    const size_t V = g_.vertex_count();
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        dist[i].store(INT_MAX, std::memory_order_relaxed);
+    });
+    dist[source].store(0);
+    bottom_up_levels_ = 0;
+
+    auto degree = [&](size_t u) -> size_t { return g_.offsets[u + 1] - g_.offsets[u]; };
+
+    Workspace::Lease workspace(Parallel::max_threads());
+    std::vector<int>& frontier = workspace->frontier(0);
+    std::vector<int>& next = workspace->frontier(1);
+    frontier.assign(1, source);
+    size_t unexplored = g_.edge_count();  // Edges not yet charged to a frontier
+    size_t awake = 1;
+    bool bottom_up = false;
+
+    for (int level = 0; ; ++level) {
+        if (!bottom_up) {
+            if (frontier.empty()) break;
+
+            const size_t frontier_edges = Parallel::sum<size_t>(frontier.size(), [&](size_t i) {
+                return degree(frontier[i]);
+            });
+            unexplored -= std::min(unexplored, frontier_edges);
+
+            if (frontier_edges <= unexplored / alpha_) {
+                auto relax = [&](int first, int last, std::vector<int>& out) {
+                    for (int e = first; e < last; ++e) {
+                        const int v = g_.edges[e];
+                        int expected = INT_MAX;
+                        if (dist[v].compare_exchange_strong(expected, level + 1)) out.push_back(v);
+                    }
+                };
+
+                // Hubs sit out the vertex-parallel pass; their edges are split over all threads after it
+                const std::vector<int>& hubs = g_.metadata().hubs;
+                const size_t hub_degree = hubs.empty() ? SIZE_MAX : static_cast<size_t>(g_.metadata().hub_degree);
+                Frontier::expand(*workspace, frontier, next, [&](int u, std::vector<int>& out) {
+                    if (degree(u) < hub_degree) relax(g_.offsets[u], g_.offsets[u + 1], out);
+                });
+                for (int h : hubs) {
+                    if (dist[h].load(std::memory_order_relaxed) != level) continue;
+                    const int first = g_.offsets[h];
+                    Parallel::for_chunks(degree(h), 1024, [&](size_t begin, size_t end, size_t thread) {
+                        relax(first + static_cast<int>(begin), first + static_cast<int>(end), workspace->local(thread));
+                    });
+                }
+                workspace->drain_locals(next);
+
+                std::swap(frontier, next);
+                continue;
+            }
+
+            // Switch to bottom-up: rebuild the bitmaps from the distances so far
+            const size_t words = front_.size();
+            Parallel::parallel_for(words, [&](size_t w) {
+                uint64_t in_front = 0, seen = 0;
+                const size_t last = std::min<size_t>(64, V - w * 64);
+                for (size_t bit = 0; bit < last; ++bit) {
+                    const int d = dist[w * 64 + bit].load(std::memory_order_relaxed);
+                    if (d == level) in_front |= uint64_t(1) << bit;
+                    if (d != INT_MAX) seen |= uint64_t(1) << bit;
+                }
+                front_[w] = in_front;
+                visited_[w] = seen;
+            });
+            awake = frontier.size();
+            bottom_up = true;
+        }
+
+        const size_t previous = awake;
+        awake = bottom_up_step<Id, Symmetric>(level, dist);
+        std::swap(front_, next_);
+        ++bottom_up_levels_;
+        if (awake == 0) break;
+
+        if (awake < previous && awake <= V / beta_) {
+            bitmap_to_frontier(frontier);
+            unexplored = Parallel::sum<size_t>(V, [&](size_t v) {
+                return dist[v].load(std::memory_order_relaxed) == INT_MAX ? degree(v) : 0;
+            });
+            bottom_up = false;
+        }
+    }
+}
+
+// The graph shapes run() dispatches to
+template void HybridBFS::run_as<int, false>(int, std::vector<std::atomic<int>>&);
+template void HybridBFS::run_as<int, true>(int, std::vector<std::atomic<int>>&);
+template void HybridBFS::run_as<uint16_t, false>(int, std::vector<std::atomic<int>>&);
+template void HybridBFS::run_as<uint16_t, true>(int, std::vector<std::atomic<int>>&);
+
+} // namespace ParallelBFS
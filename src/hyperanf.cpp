@@ -0,0 +1,137 @@
+#include "hyperanf.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace ParallelBFS {
+
+namespace {
+
+constexpr int MIN_LOG2_REGISTERS = 4;
+constexpr int MAX_LOG2_REGISTERS = 16;
+
+uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+double hll_alpha(size_t m) {
+    switch (m) {
+        case 16: return 0.673;
+        case 32: return 0.697;
+        case 64: return 0.709;
+        default: return 0.7213 / (1.0 + 1.079 / m);
+    }
+}
+
+// HyperLogLog cardinality estimate with the linear-counting small-range correction
+double hll_estimate(const uint8_t* registers, size_t m) {
+    double sum = 0;
+    size_t zeros = 0;
+    for (size_t j = 0; j < m; ++j) {
+        sum += std::ldexp(1.0, -registers[j]);
+        zeros += (registers[j] == 0);
+    }
+    double estimate = hll_alpha(m) * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(static_cast<double>(m) / zeros);
+    }
+    return estimate;
+}
+
+// dst = max(dst, src) register-wise; true if any register grew
+bool hll_union(uint8_t* dst, const uint8_t* src, size_t m) {
+    uint8_t grew = 0;
+    #pragma omp simd reduction(|:grew)
+    for (size_t j = 0; j < m; ++j) {
+        uint8_t merged = std::max(dst[j], src[j]);
+        grew |= static_cast<uint8_t>(merged != dst[j]);
+        dst[j] = merged;
+    }
+    return grew != 0;
+}
+
+} // namespace
+
+NeighborhoodFunction hyperanf(const Graph& g, const HyperANFConfig& config) {
+    const size_t V = g.vertex_count();
+
+    int log2m = std::min(std::max(config.log2_registers, MIN_LOG2_REGISTERS), MAX_LOG2_REGISTERS);
+    if (config.memory_limit_bytes > 0) {
+        while (log2m > MIN_LOG2_REGISTERS && 2 * V * (size_t(1) << log2m) > config.memory_limit_bytes) {
+            log2m--;
+        }
+        if (2 * V * (size_t(1) << log2m) > config.memory_limit_bytes) {
+            throw std::invalid_argument("HyperANF memory limit too small for " + std::to_string(V) + " vertices");
+        }
+    }
+    const size_t m = size_t(1) << log2m;
+
+    // Two generations of registers, V * m bytes each
+    std::vector<uint8_t> current(V * m, 0);
+    std::vector<uint8_t> next(V * m);
+
+    Parallel::parallel_for(V, [&](size_t x) {
+        uint64_t h = mix64(x ^ (static_cast<uint64_t>(config.seed) << 32));
+        size_t j = h >> (64 - log2m);
+        uint64_t rest = h << log2m;
+        int rank = rest == 0 ? 64 - log2m + 1 : __builtin_clzll(rest) + 1;
+        current[x * m + j] = static_cast<uint8_t>(std::min(rank, 64 - log2m + 1));
+    });
+
+    NeighborhoodFunction result;
+    result.log2_registers = log2m;
+    result.register_bytes = 2 * V * m;
+
+    auto total_estimate = [&](const std::vector<uint8_t>& registers) {
+        return Parallel::sum<double>(V, [&](size_t x) {
+            return hll_estimate(&registers[x * m], m);
+        });
+    };
+
+    result.pairs_within.push_back(total_estimate(current));
+
+    for (int t = 1; t <= config.max_iterations; ++t) {
+        const size_t changed = Parallel::sum<size_t>(V, [&](size_t x) -> size_t {
+            uint8_t* dst = &next[x * m];
+            std::copy(&current[x * m], &current[x * m] + m, dst);
+
+            bool grew = false;
+            for (int e = g.offsets[x]; e < g.offsets[x + 1]; ++e) {
+                grew |= hll_union(dst, &current[static_cast<size_t>(g.edges[e]) * m], m);
+            }
+            return grew ? 1 : 0;
+        }, 256);
+
+        if (changed == 0) break;
+        std::swap(current, next);
+        result.pairs_within.push_back(total_estimate(current));
+    }
+
+    // The neighborhood function is monotone; HLL noise may briefly break that
+    for (size_t t = 1; t < result.pairs_within.size(); ++t) {
+        result.pairs_within[t] = std::max(result.pairs_within[t], result.pairs_within[t - 1]);
+    }
+
+    const double target = config.effective_fraction * result.pairs_within.back();
+    for (size_t t = 0; t < result.pairs_within.size(); ++t) {
+        if (result.pairs_within[t] >= target) {
+            if (t == 0) {
+                result.effective_diameter = 0;
+            } else {
+                double below = result.pairs_within[t - 1];
+                double above = result.pairs_within[t];
+                result.effective_diameter = (t - 1) + (above > below ? (target - below) / (above - below) : 1.0);
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+} // namespace ParallelBFS
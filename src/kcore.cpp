@@ -0,0 +1,81 @@
+#include "kcore.h"
+#include "frontier.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+CoreDecomposition kcore(const Graph& g) {
+    const size_t V = g.vertex_count();
+    // Out-degrees of a directed graph are not the degrees peeling needs
+    if (!g.metadata().symmetric) {
+        throw std::invalid_argument("k-core decomposition needs a symmetric graph with sorted adjacency lists");
+    }
+
+    std::vector<std::atomic<int>> degree(V);
+    CoreDecomposition result;
+    result.coreness.assign(V, -1);
+    result.order.reserve(V);
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        degree[i].store(g.offsets[i + 1] - g.offsets[i], std::memory_order_relaxed);
+    });
+
+    // Vertices not yet peeled, compacted after every k
+    std::vector<int> remaining(V);
+    Parallel::parallel_for(V, [&](size_t i) { remaining[i] = static_cast<int>(i); });
+
+    Workspace::Lease workspace(Parallel::max_threads());
+    std::vector<int>& current_frontier = workspace->frontier(0);
+    std::vector<int>& next_frontier = workspace->frontier(1);
+    int k = 0;
+
+    while (!remaining.empty()) {
+        // Jump straight to the lowest remaining degree instead of scanning empty buckets
+        const int min_degree = Parallel::reduce(remaining.size(), INT_MAX,
+            [&](size_t i) { return degree[remaining[i]].load(std::memory_order_relaxed); },
+            [](int a, int b) { return std::min(a, b); });
+        k = std::max(k, min_degree);
+
+        current_frontier.clear();
+        Parallel::for_chunks(remaining.size(), 0, [&](size_t begin, size_t end, size_t thread) {
+            std::vector<int>& mine = workspace->local(thread);
+            for (size_t i = begin; i < end; ++i) {
+                if (degree[remaining[i]].load(std::memory_order_relaxed) <= k) {
+                    mine.push_back(remaining[i]);
+                }
+            }
+        });
+        workspace->drain_locals(current_frontier);
+
+        while (!current_frontier.empty()) {
+            for (int u : current_frontier) result.coreness[u] = k;
+            result.order.insert(result.order.end(), current_frontier.begin(), current_frontier.end());
+
+            Frontier::expand(*workspace, current_frontier, next_frontier, [&](int u, std::vector<int>& out) {
+                for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    const int v = g.edges[e];
+                    if (result.coreness[v] >= 0) continue;
+                    // Exactly one decrement takes v from k + 1 down to k
+                    if (degree[v].fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                        out.push_back(v);
+                    }
+                }
+            });
+            std::swap(current_frontier, next_frontier);
+        }
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&](int v) { return result.coreness[v] >= 0; }),
+                        remaining.end());
+        ++k;
+    }
+
+    result.degeneracy = k > 0 ? k - 1 : 0;
+    return result;
+}
+
+} // namespace ParallelBFS
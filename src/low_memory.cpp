@@ -0,0 +1,230 @@
+#include "low_memory.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace LowMemory {
+
+namespace {
+
+constexpr size_t READ_BLOCK = size_t(1) << 20;
+
+// Streams "u v [w]" lines from `filename` through a fixed buffer and calls
+// fn(u, v) for each edge; blank, '#' and '%' lines are skipped.
+template <typename Fn>
+void scan_edges(const std::string& filename, Fn&& fn) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(filename.c_str(), "rb"), std::fclose);
+    if (!file) throw std::runtime_error("Could not open file: " + filename);
+
+    std::vector<char> buffer(READ_BLOCK + 1);
+    size_t filled = 0;
+    size_t line_no = 0;
+    bool eof = false;
+
+    auto malformed = [&]() {
+        return std::runtime_error("Malformed edge on line " + std::to_string(line_no) + " of " + filename);
+    };
+    auto parse_id = [&](const char*& p) {
+        while (*p == ' ' || *p == '\t') ++p;
+        if (*p < '0' || *p > '9') throw malformed();
+        uint64_t x = 0;
+        for (; *p >= '0' && *p <= '9'; ++p) {
+            x = x * 10 + static_cast<uint64_t>(*p - '0');
+            if (x >= std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error("Vertex ID on line " + std::to_string(line_no) + " of " + filename +
+                                         " does not fit in 32 bits");
+            }
+        }
+        return static_cast<uint32_t>(x);
+    };
+
+    while (!eof || filled > 0) {
+        if (!eof) {
+            filled += std::fread(buffer.data() + filled, 1, READ_BLOCK - filled, file.get());
+            eof = filled < READ_BLOCK;
+        }
+
+        size_t start = 0;
+        while (start < filled) {
+            char* newline = static_cast<char*>(std::memchr(buffer.data() + start, '\n', filled - start));
+            if (newline == nullptr) {
+                if (!eof) break;
+                newline = buffer.data() + filled;  // Unterminated last line
+            }
+            *newline = '\0';
+            ++line_no;
+
+            const char* p = buffer.data() + start;
+            while (*p == ' ' || *p == '\t') ++p;
+            if (*p != '\0' && *p != '\r' && *p != '#' && *p != '%') {
+                const uint32_t u = parse_id(p);
+                if (*p != ' ' && *p != '\t') throw malformed();
+                const uint32_t v = parse_id(p);
+                fn(u, v);
+            }
+            start = static_cast<size_t>(newline - buffer.data()) + 1;
+        }
+
+        if (start == 0 && filled == READ_BLOCK) {
+            throw std::runtime_error("Line " + std::to_string(line_no + 1) + " of " + filename + " is too long");
+        }
+        start = std::min(start, filled);
+        std::memmove(buffer.data(), buffer.data() + start, filled - start);
+        filled -= start;
+        if (eof && filled == 0) break;
+    }
+    if (std::ferror(file.get())) throw std::runtime_error("Error reading " + filename);
+}
+
+double gib(size_t bytes) { return bytes / (1024.0 * 1024.0 * 1024.0); }
+
+size_t physical_memory() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page > 0) return static_cast<size_t>(pages) * static_cast<size_t>(page);
+#endif
+    return 0;
+}
+
+} // namespace
+
+MemoryProjection project(size_t vertices, size_t edges) {
+    MemoryProjection p;
+    p.graph_bytes = (vertices + 1) * sizeof(uint64_t) + edges * sizeof(uint32_t);
+    p.traversal_bytes = 3 * ((vertices + 63) / 64) * sizeof(uint64_t) + vertices;
+    return p;
+}
+
+CompactGraph load(const std::string& filename, std::ostream* report) {
+    CompactGraph g;
+
+    // Pass 1: out-degree of u accumulates in offsets[u + 1]
+    std::vector<uint64_t>& offsets = g.offsets;
+    uint32_t max_vertex = 0;
+    size_t edge_count = 0;
+    scan_edges(filename, [&](uint32_t u, uint32_t v) {
+        if (u + size_t(2) > offsets.size()) {
+            if (u + size_t(2) > offsets.capacity()) offsets.reserve(std::max<size_t>(u + size_t(2), offsets.capacity() * 2));
+            offsets.resize(u + size_t(2), 0);
+        }
+        offsets[u + 1]++;
+        max_vertex = std::max({max_vertex, u, v});
+        ++edge_count;
+    });
+    const size_t V = static_cast<size_t>(max_vertex) + 1;
+    offsets.resize(V + 1, 0);
+    offsets.shrink_to_fit();
+
+    if (report != nullptr) {
+        const MemoryProjection p = project(V, edge_count);
+        *report << "Low-memory load of " << filename << ": " << V << " vertices, " << edge_count << " edges\n"
+                << "  Projected peak: " << gib(p.peak_bytes()) << " GiB (graph " << gib(p.graph_bytes)
+                << " GiB + traversal " << gib(p.traversal_bytes) << " GiB)";
+        if (const size_t physical = physical_memory()) {
+            *report << " of " << gib(physical) << " GiB physical";
+            if (p.peak_bytes() > physical) *report << " - WILL NOT FIT";
+        }
+        *report << "\n";
+    }
+
+    for (size_t i = 1; i <= V; ++i) offsets[i] += offsets[i - 1];
+
+    // Pass 2: offsets[u] doubles as u's write cursor and ends up at u's end
+    g.edges.resize(edge_count);
+    size_t placed = 0;
+    scan_edges(filename, [&](uint32_t u, uint32_t v) {
+        if (u >= V || v >= V || placed == edge_count) {
+            throw std::runtime_error(filename + " changed while loading");
+        }
+        g.edges[offsets[u]++] = v;
+        ++placed;
+    });
+    if (placed != edge_count) throw std::runtime_error(filename + " changed while loading");
+
+    // Shift the cursors back into start offsets
+    for (size_t u = V - 1; u > 0; --u) offsets[u] = offsets[u - 1];
+    offsets[0] = 0;
+    return g;
+}
+
+CompactGraph compact(const Graph& g) {
+    CompactGraph c;
+    c.offsets.resize(g.offsets.size());
+    c.edges.resize(g.edges.size());
+    Parallel::parallel_for(c.offsets.size(), [&](size_t i) {
+        c.offsets[i] = static_cast<uint64_t>(g.offsets[i]);
+    });
+    Parallel::parallel_for(c.edges.size(), [&](size_t e) {
+        c.edges[e] = static_cast<uint32_t>(g.edges[e]);
+    });
+    return c;
+}
+
+BFSResult bfs(const CompactGraph& g, uint32_t source, std::vector<uint8_t>& level) {
+    const size_t V = g.vertex_count();
+    if (source >= V) throw std::out_of_range("Source vertex out of range");
+
+    const size_t words = (V + 63) / 64;
+    std::vector<std::atomic<uint64_t>> visited(words), frontier_a(words), frontier_b(words);
+    Parallel::parallel_for(words, [&](size_t w) {
+        visited[w].store(0, std::memory_order_relaxed);
+        frontier_a[w].store(0, std::memory_order_relaxed);
+        frontier_b[w].store(0, std::memory_order_relaxed);
+    });
+    level.resize(V);
+    Parallel::parallel_for(V, [&](size_t i) { level[i] = UNREACHED; });
+
+    const uint64_t* offsets = g.offsets.data();
+    const uint32_t* edges = g.edges.data();
+    std::vector<std::atomic<uint64_t>>* current = &frontier_a;
+    std::vector<std::atomic<uint64_t>>* next = &frontier_b;
+
+    visited[source / 64].store(uint64_t(1) << (source % 64), std::memory_order_relaxed);
+    (*current)[source / 64].store(uint64_t(1) << (source % 64), std::memory_order_relaxed);
+    level[source] = 0;
+
+    BFSResult result;
+    result.reached = 1;
+    for (int depth = 0; ; ++depth) {
+        const uint8_t stored = static_cast<uint8_t>(std::min(depth + 1, static_cast<int>(LEVEL_CAP)));
+
+        const size_t found = Parallel::sum<size_t>(words, [&](size_t w) -> size_t {
+            size_t claimed = 0;
+            for (uint64_t bits = (*current)[w].load(std::memory_order_relaxed); bits; bits &= bits - 1) {
+                const size_t u = w * 64 + __builtin_ctzll(bits);
+                for (uint64_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                    const uint32_t v = edges[e];
+                    std::atomic<uint64_t>& seen = visited[v / 64];
+                    const uint64_t bit = uint64_t(1) << (v % 64);
+                    if (seen.load(std::memory_order_relaxed) & bit) continue;
+                    if (seen.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                    (*next)[v / 64].fetch_or(bit, std::memory_order_relaxed);
+                    level[v] = stored;
+                    ++claimed;
+                }
+            }
+            return claimed;
+        }, 64);
+
+        if (found == 0) break;
+        result.reached += found;
+        result.levels = depth + 1;
+
+        std::swap(current, next);
+        std::vector<std::atomic<uint64_t>>& stale = *next;
+        Parallel::parallel_for(words, [&](size_t w) { stale[w].store(0, std::memory_order_relaxed); });
+    }
+    return result;
+}
+
+} // namespace LowMemory
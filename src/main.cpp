@@ -1,13 +1,64 @@
 #include "parallel_bfs.h"
+#include "bipartite.h"
+#include "sssp.h"
+#include "hyperanf.h"
+#include "apsp.h"
+#include "kcore.h"
+#include "partition.h"
+#include "distance_stats.h"
+#include "thread_pool.h"
+#include "topology.h"
+#include "numa_bfs.h"
+#include "async_bfs.h"
+#include "hybrid_bfs.h"
+#include "binned_bfs.h"
+#include "distributed_bfs.h"
+#include "low_memory.h"
+#include "graph_stats.h"
+#include "simd_kernels.h"
+#include "parallel_backend.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
 #include <string>
 #include <climits>
-#include <omp.h>  // Add this for INT_MAX
+#include <limits>
 
 void print_usage() {
-    std::cout << "Usage: ./parallel_bfs [vertices=1000] [density=0.01] [seed=42]\n"
+    std::cout << "Usage: ./parallel_bfs [options] [vertices=1000] [density=0.01] [seed=42]\n"
+              << "       ./parallel_bfs [options] <graph.txt | graph.bin>\n"
+              << "Options:\n"
+              << "  --mode=<name>   Engine to run (default multi_source)\n"
+              << "  --parts=<n>     Partition count for --mode=partition (default 2)\n"
+              << "  --samples=<n>   BFS sources for --mode=histogram (default 64)\n"
+              << "  --pin=<policy>  Thread placement: none, compact, scatter, core (default none)\n"
+              << "  --nodes=<n>     Partitions for --mode=numa_bfs (default: detected NUMA nodes)\n"
+              << "  --bucket=<w>    Distance bucket width for --mode=async_bfs, at least 1 (default 1)\n"
+              << "  --bin=<n>       Vertices per bin for --mode=binned_bfs (default 65536)\n"
+              << "  --ranks=<n>     Local processes for the dist modes (default 4)\n"
+              << "  --transport=<t> Rank transport for the dist modes: shm, socket (default shm)\n"
+              << "  --validate      Check single-source results against the BFS invariants\n"
+              << "  --save=<file>   Write the loaded graph and its metadata in binary form\n"
+              << "  --stats         Scan degrees, self-loops, duplicate edges and symmetry before running\n"
+              << "  --force         With --stats, run on graphs with self-loops or duplicate edges\n"
+              << "Modes:\n"
+              << "  multi_source  BFS from every unvisited vertex (default)\n"
+              << "  bipartite     Bipartiteness check with odd-cycle witness (symmetric graphs)\n"
+              << "  sssp          Delta-stepping shortest paths from vertex 0 (uses the weight column)\n"
+              << "  dial          Bucketed BFS from vertex 0 for integer weights in [0, 255]\n"
+              << "  hyperanf      HyperANF hop-plot and effective diameter estimate\n"
+              << "  apsp          Bit-parallel all-pairs hop distances (up to 65536 vertices)\n"
+              << "  kcore         Parallel k-core decomposition (symmetric graphs)\n"
+              << "  partition     Label-propagation partitioner with edge-cut report\n"
+              << "  histogram     Distance distribution over sampled BFS sources\n"
+              << "  pool_bfs      Single-source BFS from vertex 0 on the persistent thread pool\n"
+              << "  numa_bfs      NUMA-partitioned BFS from vertex 0 with per-node mailboxes\n"
+              << "  async_bfs     Barrier-free label-correcting BFS from vertex 0\n"
+              << "  hybrid_bfs    Direction-optimizing top-down/bottom-up BFS from vertex 0\n"
+              << "  binned_bfs    Propagation-blocking BFS from vertex 0 with per-bin updates\n"
+              << "  dist_bfs      1D-partitioned multi-process BFS from vertex 0 on local ranks\n"
+              << "  dist2d_bfs    2D checkerboard multi-process BFS from vertex 0 with compressed frontiers\n"
+              << "  lowmem_bfs    BFS from vertex 0 on a 32-bit CSR with bitmap frontiers and byte levels\n"
               << "Safe test examples:\n"
               << "  ./parallel_bfs 100 0.1      # Tiny test (100 vertices, 10% density)\n"
               << "  ./parallel_bfs 1000 0.01    # Small test (default)\n"
@@ -17,6 +68,16 @@ void print_usage() {
               << "  ./parallel_bfs 1000000 0.0001\n";
 }
 
+// Runs the invariant check outside the timed region and reports its verdict
+template <typename Dist>
+void print_validation(const Graph& g, int source, const Dist& dist) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const bool valid = ParallelBFS::validate_result(g, source, dist);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Valid:      " << (valid ? "yes" : "NO") << " (checked in "
+              << std::chrono::duration<double>(end - start).count() << " s)\n";
+}
+
 int main(int argc, char* argv[]) {
     // Default safe values
     size_t V = 1000;
@@ -24,24 +85,80 @@ int main(int argc, char* argv[]) {
     unsigned seed = 42;
     std::string graph_file;
     bool from_file = false;
+    std::string mode = "multi_source";
+    int parts = 2;
+    size_t samples = 64;
+    Topology::PinPolicy pin = Topology::PinPolicy::None;
+    size_t numa_nodes = 0;
+    int bucket_width = 1;
+    size_t bin_vertices = ParallelBFS::DEFAULT_BIN_VERTICES;
+    int ranks = 4;
+    Distributed::TransportKind transport = Distributed::TransportKind::SharedMemory;
+    bool validate = false;
+    bool full_stats = false;
+    bool force = false;
+    std::string save_file;
+
+    // Split --option=<value> flags off the positional arguments
+    std::vector<std::string> args;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--mode=", 0) == 0) {
+                mode = arg.substr(7);
+            } else if (arg.rfind("--parts=", 0) == 0) {
+                parts = std::stoi(arg.substr(8));
+            } else if (arg.rfind("--samples=", 0) == 0) {
+                samples = std::stoul(arg.substr(10));
+            } else if (arg.rfind("--pin=", 0) == 0) {
+                pin = Topology::parse_policy(arg.substr(6));
+            } else if (arg.rfind("--nodes=", 0) == 0) {
+                numa_nodes = std::stoul(arg.substr(8));
+            } else if (arg.rfind("--bucket=", 0) == 0) {
+                bucket_width = std::stoi(arg.substr(9));
+                if (bucket_width < 1) throw std::invalid_argument("--bucket must be at least 1");
+            } else if (arg.rfind("--bin=", 0) == 0) {
+                bin_vertices = std::stoul(arg.substr(6));
+            } else if (arg.rfind("--ranks=", 0) == 0) {
+                ranks = std::stoi(arg.substr(8));
+            } else if (arg.rfind("--transport=", 0) == 0) {
+                transport = Distributed::parse_transport(arg.substr(12));
+            } else if (arg.rfind("--save=", 0) == 0) {
+                save_file = arg.substr(7);
+            } else if (arg == "--validate") {
+                validate = true;
+            } else if (arg == "--stats") {
+                full_stats = true;
+            } else if (arg == "--force") {
+                force = true;
+            } else {
+                args.push_back(arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid arguments: " << e.what() << "\n";
+        print_usage();
+        return 1;
+    }
 
     // Parse command-line arguments
-    if (argc > 1) {
-        if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+    if (!args.empty()) {
+        if (args[0] == "-h" || args[0] == "--help") {
             print_usage();
             return 0;
         }
         
-        // Check if argument is a file (ends with .txt)
-        std::string first_arg = argv[1];
-        if (first_arg.size() >= 4 && first_arg.substr(first_arg.size() - 4) == ".txt") {
+        // Check if argument is a file (ends with .txt or .bin)
+        const std::string& first_arg = args[0];
+        const std::string extension = first_arg.size() >= 4 ? first_arg.substr(first_arg.size() - 4) : "";
+        if (extension == ".txt" || extension == ".bin") {
             graph_file = first_arg;
             from_file = true;
         } else {
             try {
-                V = std::stoul(argv[1]);
-                if (argc > 2) density = std::stof(argv[2]);
-                if (argc > 3) seed = std::stoul(argv[3]);
+                V = std::stoul(args[0]);
+                if (args.size() > 1) density = std::stof(args[1]);
+                if (args.size() > 2) seed = std::stoul(args[2]);
             } catch (...) {
                 std::cerr << "Invalid arguments!\n";
                 print_usage();
@@ -50,10 +167,47 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    const std::vector<std::string> modes = {"multi_source", "bipartite", "sssp", "dial", "hyperanf", "apsp", "kcore", "partition", "histogram", "pool_bfs", "numa_bfs", "async_bfs", "hybrid_bfs", "binned_bfs", "dist_bfs", "dist2d_bfs", "lowmem_bfs"};
+    if (std::find(modes.begin(), modes.end(), mode) == modes.end()) {
+        std::cerr << "Unknown mode: " << mode << "\n";
+        print_usage();
+        return 1;
+    }
+
+    if (pin != Topology::PinPolicy::None) {
+        std::vector<int> cpus = Topology::pin_worker_threads(pin);
+        std::cout << "Topology: " << Topology::describe(Topology::detect()) << "\n"
+                  << "Placement (" << Topology::policy_name(pin) << "):";
+        for (int cpu : cpus) std::cout << " " << cpu;
+        std::cout << (cpus.empty() ? "\n" : ", thread 0 keeps the caller's CPUs\n");
+    }
+
     try {
+        if (mode == "lowmem_bfs") {
+            // Never builds a Graph from the file: its int offsets and the atomic<int> distances are what this avoids
+            CompactGraph g = from_file ? LowMemory::load(graph_file, &std::cout)
+                                       : LowMemory::compact(GraphGenerator::random(V, density, seed));
+
+            std::cout << "Running low-memory BFS from vertex 0\n";
+            std::vector<uint8_t> level;
+            auto start = std::chrono::high_resolution_clock::now();
+            LowMemory::BFSResult result = LowMemory::bfs(g, 0, level);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Throughput: " << (g.edge_count() / std::chrono::duration<double>(end - start).count() / 1e6) << " M edges/s\n"
+                      << "  Graph:      " << g.memory_bytes() / (1024.0 * 1024.0) << " MB\n"
+                      << "  Levels:     " << result.levels << "\n"
+                      << "  Reachable:  " << result.reached << "/" << g.vertex_count() << " vertices\n";
+            return 0;
+        }
+
         // Initialize graph based on input
-        Graph g = from_file ? GraphGenerator::from_file(graph_file) 
-                           : GraphGenerator::random(V, density, seed);
+        const bool binary = graph_file.size() >= 4 && graph_file.substr(graph_file.size() - 4) == ".bin";
+        Graph g = !from_file ? GraphGenerator::random(V, density, seed)
+                  : binary   ? GraphGenerator::from_binary(graph_file)
+                             : GraphGenerator::from_file(graph_file);
 
         // Safety check for synthetic graph
         if (!from_file && V > 10000) {
@@ -70,10 +224,340 @@ int main(int argc, char* argv[]) {
                       << "  Seed:     " << seed << "\n";
         }
 
-        std::cout << "Graph stats:\n"
-                  << "  Vertices: " << g.vertex_count() << "\n"
-                  << "  Edges:    " << g.edge_count() << "\n"
-                  << "  Avg deg:  " << g.avg_degree << "\n";
+        // Out-of-range targets are rejected here, before any engine indexes through them
+        if (!full_stats) {
+            std::cout << "Graph stats:\n"
+                      << "  Vertices: " << g.vertex_count() << "\n"
+                      << "  Edges:    " << g.edge_count() << "\n"
+                      << "  Avg deg:  " << g.avg_degree << "\n";
+            // from_binary has validated the graph already
+            if (!binary && !g.validate()) {
+                throw std::runtime_error("Graph has edge targets outside [0, " + std::to_string(g.vertex_count()) + ")");
+            }
+        } else {
+            auto stats_start = std::chrono::high_resolution_clock::now();
+            const ParallelBFS::GraphStats stats = ParallelBFS::graph_stats(g);
+            auto stats_end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "Graph stats (" << std::chrono::duration<double>(stats_end - stats_start).count() << " s):\n"
+                      << "  Vertices: " << g.vertex_count() << "\n"
+                      << "  Edges:    " << g.edge_count() << "\n";
+            ParallelBFS::print_graph_stats(stats, std::cout);
+            std::cout << "  Hubs:     " << stats.metadata.hubs.size() << " (degree >= " << stats.metadata.hub_degree << ")"
+                      << (stats.metadata.symmetric ? ", symmetric" : "") << "\n";
+            g.set_metadata(stats.metadata);
+            if (stats.invalid_targets > 0) {
+                throw std::runtime_error(std::to_string(stats.invalid_targets) + " edge targets are outside [0, " +
+                                         std::to_string(g.vertex_count()) + ")");
+            }
+            if (!stats.clean() && !force) {
+                throw std::runtime_error("Graph has self-loops or duplicate edges; rerun with --force to use it anyway");
+            }
+        }
+        if (!save_file.empty()) {
+            GraphGenerator::save_binary(g, save_file);
+            std::cout << "Saved " << save_file << "\n";
+        }
+
+        if (mode == "bipartite") {
+            std::cout << "Running parallel bipartiteness check\n";
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::BipartiteResult result = ParallelBFS::bipartite(g);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Bipartite:  " << (result.bipartite ? "yes" : "no") << "\n";
+            if (!result.bipartite) {
+                std::cout << "  Odd cycle:  length " << result.odd_cycle.size() << ":";
+                for (size_t i = 0; i < std::min<size_t>(result.odd_cycle.size(), 16); ++i) {
+                    std::cout << " " << result.odd_cycle[i];
+                }
+                if (result.odd_cycle.size() > 16) std::cout << " ...";
+                std::cout << "\n";
+            }
+            return 0;
+        }
+        if (mode == "sssp") {
+            std::cout << "Running parallel delta-stepping SSSP from vertex 0"
+                      << (g.weighted() ? "" : " (unweighted, BFS fallback)") << "\n";
+            std::vector<std::atomic<float>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::delta_stepping(g, 0, dist);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const float inf = std::numeric_limits<float>::infinity();
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != inf ? 1 : 0;
+            });
+            const float max_dist = Parallel::reduce(dist.size(), 0.0f,
+                [&](size_t i) { float d = dist[i].load(); return d != inf ? d : 0.0f; },
+                [](float a, float b) { return std::max(a, b); });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n"
+                      << "  Max dist:   " << max_dist << "\n";
+            return 0;
+        }
+
+        if (mode == "dial") {
+            std::cout << "Running parallel small-integer-weight BFS from vertex 0\n";
+            std::vector<uint8_t> weights = ParallelBFS::small_integer_weights(g);
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::dial_bfs(g, weights, 0, dist);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != INT_MAX ? 1 : 0;
+            });
+            const int max_dist = Parallel::reduce(dist.size(), 0,
+                [&](size_t i) { int d = dist[i].load(); return d != INT_MAX ? d : 0; },
+                [](int a, int b) { return std::max(a, b); });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n"
+                      << "  Max dist:   " << max_dist << "\n";
+            return 0;
+        }
+
+        if (mode == "hyperanf") {
+            std::cout << "Running parallel HyperANF\n";
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::NeighborhoodFunction nf = ParallelBFS::hyperanf(g);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "\nHop plot (t: pairs within t hops):\n";
+            for (size_t t = 0; t < nf.pairs_within.size(); ++t) {
+                std::cout << "  " << t << ": " << nf.pairs_within[t] << "\n";
+            }
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Registers:  " << (1 << nf.log2_registers) << " per vertex ("
+                      << nf.register_bytes / (1024.0 * 1024.0) << " MB)\n"
+                      << "  Eff. diam:  " << nf.effective_diameter << "\n";
+            return 0;
+        }
+
+        if (mode == "apsp") {
+            std::cout << "Running bit-parallel all-pairs BFS\n";
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::DistanceMatrix matrix = ParallelBFS::all_pairs_bfs(g);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            // Per source row: (reachable targets, distance sum, eccentricity)
+            struct RowStats { size_t pairs = 0; double sum = 0; int max = 0; };
+            const size_t n = matrix.n;
+            const RowStats total = Parallel::reduce(n, RowStats{},
+                [&](size_t s) {
+                    RowStats row;
+                    for (size_t t = 0; t < n; ++t) {
+                        uint8_t d = matrix.at(s, t);
+                        if (d != ParallelBFS::DistanceMatrix::UNREACHABLE && s != t) {
+                            row.pairs++;
+                            row.sum += d;
+                            row.max = std::max(row.max, static_cast<int>(d));
+                        }
+                    }
+                    return row;
+                },
+                [](RowStats a, const RowStats& b) {
+                    a.pairs += b.pairs;
+                    a.sum += b.sum;
+                    a.max = std::max(a.max, b.max);
+                    return a;
+                });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Matrix:     " << matrix.data.size() / (1024.0 * 1024.0) << " MB\n"
+                      << "  Reachable:  " << total.pairs << " ordered pairs\n"
+                      << "  Mean dist:  " << (total.pairs ? total.sum / total.pairs : 0.0) << "\n"
+                      << "  Diameter:   " << total.max << "\n";
+            return 0;
+        }
+
+        if (mode == "kcore") {
+            std::cout << "Running parallel k-core decomposition\n";
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::CoreDecomposition cores = ParallelBFS::kcore(g);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            size_t top_core = std::count(cores.coreness.begin(), cores.coreness.end(), cores.degeneracy);
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Degeneracy: " << cores.degeneracy << "\n"
+                      << "  Top core:   " << top_core << " vertices\n";
+            return 0;
+        }
+
+        if (mode == "partition") {
+            std::cout << "Running parallel partitioner (" << parts << " parts)\n";
+            ParallelBFS::PartitionConfig config;
+            config.parts = parts;
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::Partition partition = ParallelBFS::partition(g, config);
+            Graph relabeled = ParallelBFS::relabel(g, partition.new_id);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Edge cut:   " << partition.edge_cut << "/" << g.edge_count() << " ("
+                      << (100.0 * partition.edge_cut / std::max<size_t>(1, g.edge_count())) << "%)\n"
+                      << "  Imbalance:  " << partition.imbalance << "\n";
+            for (int p = 0; p < parts; ++p) {
+                std::cout << "  Part " << p << ":     vertices [" << partition.part_offsets[p] << ", "
+                          << partition.part_offsets[p + 1] << "), " << partition.part_edges[p] << " edges\n";
+            }
+            std::cout << "  Relabeled:  " << (relabeled.validate() ? "valid" : "INVALID") << " CSR\n";
+            return 0;
+        }
+
+        if (mode == "histogram") {
+            std::cout << "Running sampled distance histogram (" << samples << " sources)\n";
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::DistanceHistogram hist = ParallelBFS::distance_histogram(g, samples, seed);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::cout << "\nDistance histogram (d: pairs):\n";
+            for (size_t d = 1; d < hist.level_counts.size(); ++d) {
+                std::cout << "  " << d << ": " << hist.level_counts[d] << "\n";
+            }
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Sources:    " << hist.samples << "\n"
+                      << "  Reachable:  " << hist.reachable_pairs << " pairs ("
+                      << 100.0 * hist.reachable_fraction << "%)\n"
+                      << "  Mean dist:  " << hist.mean_distance << "\n"
+                      << "  Median:     " << hist.median_distance << "\n";
+            return 0;
+        }
+
+        if (mode == "pool_bfs" || mode == "async_bfs") {
+            ThreadPool pool(Parallel::max_threads(), Topology::placement(Topology::detect(), pin, Parallel::max_threads()));
+            std::cout << "Running " << (mode == "async_bfs" ? "asynchronous " : "")
+                      << "BFS on a " << pool.size() << "-worker thread pool\n";
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            if (mode == "pool_bfs") {
+                ParallelBFS::optimized(g, 0, dist, pool);
+            } else {
+                ParallelBFS::async_bfs(g, 0, dist, pool, bucket_width);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != INT_MAX ? 1 : 0;
+            });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Throughput: " << (g.edge_count() / std::chrono::duration<double>(end - start).count() / 1e6) << " M edges/s\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n";
+            if (validate) print_validation(g, 0, dist);
+            return 0;
+        }
+
+        if (mode == "numa_bfs") {
+            ParallelBFS::NumaBFS engine(g, numa_nodes, Parallel::max_threads());
+            std::cout << "Running NUMA-partitioned BFS over " << engine.nodes() << " node(s)"
+                      << (engine.pinned() ? ", workers pinned per node" : "") << "\n";
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            engine.run(0, dist);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != INT_MAX ? 1 : 0;
+            });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Throughput: " << (g.edge_count() / std::chrono::duration<double>(end - start).count() / 1e6) << " M edges/s\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n";
+            if (validate) print_validation(g, 0, dist);
+            return 0;
+        }
+
+        if (mode == "hybrid_bfs") {
+            ParallelBFS::HybridBFS engine(g);
+            std::cout << "Running direction-optimizing BFS (" << Kernels::isa() << " kernels"
+                      << (engine.symmetric() ? ", symmetric graph" : ", transposed in-edges")
+                      << (engine.narrow_ids() ? ", 16-bit IDs" : ", 32-bit IDs") << ")\n";
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            engine.run(0, dist);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != INT_MAX ? 1 : 0;
+            });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Throughput: " << (g.edge_count() / std::chrono::duration<double>(end - start).count() / 1e6) << " M edges/s\n"
+                      << "  Bottom-up:  " << engine.bottom_up_levels() << " levels\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n";
+            if (validate) print_validation(g, 0, dist);
+            return 0;
+        }
+
+        if (mode == "binned_bfs") {
+            const size_t bins = (g.vertex_count() + bin_vertices - 1) / std::max<size_t>(1, bin_vertices);
+            std::cout << "Running propagation-blocking BFS over " << bins << " bin(s) of "
+                      << bin_vertices << " vertices\n";
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            auto start = std::chrono::high_resolution_clock::now();
+            ParallelBFS::binned_bfs(g, 0, dist, bin_vertices);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+                return dist[i].load() != INT_MAX ? 1 : 0;
+            });
+
+            std::cout << "\nFinal Results:\n"
+                      << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
+                      << "  Throughput: " << (g.edge_count() / std::chrono::duration<double>(end - start).count() / 1e6) << " M edges/s\n"
+                      << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n";
+            if (validate) print_validation(g, 0, dist);
+            return 0;
+        }
+
+        if (mode == "dist_bfs" || mode == "dist2d_bfs") {
+            const bool checkerboard = mode == "dist2d_bfs";
+            if (checkerboard) {
+                const std::pair<int, int> grid = ParallelBFS::grid_shape(ranks);
+                std::cout << "Running 2D-partitioned BFS on a " << grid.first << "x" << grid.second << " grid of local ranks over ";
+            } else {
+                std::cout << "Running 1D-partitioned BFS on " << ranks << " local ranks over ";
+            }
+            std::cout << Distributed::transport_name(transport) << "\n";
+            // Ranks must not touch the parallel backend, so rank 0 hands its distances back for checking here
+            Distributed::SharedBuffer returned(validate ? g.vertex_count() * sizeof(int) : 0);
+            const int status = Distributed::launch(ranks, transport, [&](Distributed::Transport& t) {
+                ParallelBFS::DistributedResult result = checkerboard ? ParallelBFS::distributed_bfs_2d(g, 0, t)
+                                                                     : ParallelBFS::distributed_bfs(g, 0, t);
+                if (t.rank() != 0) return 0;
+
+                const size_t reachable = std::count_if(result.dist.begin(), result.dist.end(),
+                                                       [](int d) { return d != INT_MAX; });
+                std::cout << "\nFinal Results:\n"
+                          << "  Time:       " << result.seconds << " s\n"
+                          << "  Throughput: " << (g.edge_count() / result.seconds / 1e6) << " M edges/s\n"
+                          << "  Levels:     " << result.levels << "\n"
+                          << "  Exchanged:  " << result.bytes_sent / 1024.0 << " KB\n"
+                          << "  Reachable:  " << reachable << "/" << g.vertex_count() << " vertices\n";
+                if (validate) std::copy(result.dist.begin(), result.dist.end(), reinterpret_cast<int*>(returned.data()));
+                return 0;
+            });
+            if (status == 0 && validate) {
+                const int* dist = reinterpret_cast<const int*>(returned.data());
+                print_validation(g, 0, std::vector<int>(dist, dist + g.vertex_count()));
+            }
+            return status;
+        }
 
         std::vector<std::atomic<int>> dist(g.vertex_count());
         for (auto& d : dist) d.store(INT_MAX);
@@ -84,11 +568,9 @@ int main(int argc, char* argv[]) {
         auto end = std::chrono::high_resolution_clock::now();
 
         // Count reachable vertices
-        size_t reachable = 0;
-        #pragma omp parallel for reduction(+:reachable)
-        for (size_t i = 0; i < dist.size(); ++i) {
-            if (dist[i].load() != INT_MAX) reachable++;
-        }
+        const size_t reachable = Parallel::sum<size_t>(dist.size(), [&](size_t i) {
+            return dist[i].load() != INT_MAX ? 1 : 0;
+        });
 
         std::cout << "\nFinal Results:\n"
                 << "  Time:       " << std::chrono::duration<double>(end - start).count() << " s\n"
@@ -0,0 +1,161 @@
+#include "numa_bfs.h"
+#include "topology.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+NumaBFS::NumaBFS(const Graph& g, size_t nodes, size_t threads) {
+    const Topology::CpuTopology& topology = Topology::detect();
+    const size_t V = g.vertex_count();
+    const size_t E = g.edge_count();
+
+    const size_t detected = std::max<size_t>(1, topology.nodes);
+    if (nodes == 0) nodes = detected;
+    nodes = std::max<size_t>(1, std::min(nodes, V));
+    if (threads == 0) threads = topology.cpus.size();
+    threads = std::max(threads, nodes);
+
+    // Contiguous ranges with balanced edge counts: node n starts at the first
+    // vertex whose edges begin at or after n * E / nodes
+    bounds_.assign(nodes + 1, 0);
+    for (size_t n = 1; n < nodes; ++n) {
+        const int target = static_cast<int>(E * n / nodes);
+        auto it = std::lower_bound(g.offsets.begin(), g.offsets.end() - 1, target);
+        bounds_[n] = std::max(bounds_[n - 1], static_cast<int>(it - g.offsets.begin()));
+    }
+    bounds_[nodes] = static_cast<int>(V);
+
+    // Worker w serves node w % nodes; pin it to that node's CPUs when the nodes are real
+    std::vector<int> cpus;
+    if (nodes == detected && detected > 1) {
+        std::vector<std::vector<int>> node_cpus(nodes);
+        for (const Topology::Cpu& c : topology.cpus) node_cpus[c.node].push_back(c.id);
+        cpus.resize(threads);
+        for (size_t w = 0; w < threads; ++w) {
+            const std::vector<int>& mine = node_cpus[w % nodes];
+            cpus[w] = mine.empty() ? -1 : mine[(w / nodes) % mine.size()];
+        }
+        pinned_ = true;
+    }
+
+    slices_.resize(nodes);
+    pool_.reset(new ThreadPool(threads, cpus));
+    local_next_.resize(threads);
+    outbox_.assign(threads, std::vector<std::vector<int>>(nodes));
+
+    // Rank 0 of each node allocates its slice so first touch places it locally
+    pool_->run([&](size_t w) {
+        if (rank_of(w) != 0) return;
+        const size_t n = node_of(w);
+        Slice& s = slices_[n];
+        s.first = bounds_[n];
+        s.last = bounds_[n + 1];
+
+        const int base = g.offsets[s.first];
+        s.offsets.resize(s.last - s.first + 1);
+        for (int v = s.first; v <= s.last; ++v) s.offsets[v - s.first] = g.offsets[v] - base;
+        s.edges.assign(g.edges.begin() + base, g.edges.begin() + g.offsets[s.last]);
+
+        s.dist.reset(new std::atomic<int>[std::max(1, s.last - s.first)]);
+        for (int i = 0; i < s.last - s.first; ++i) s.dist[i].store(INT_MAX, std::memory_order_relaxed);
+        s.frontier.reserve(1024);
+    });
+}
+
+size_t NumaBFS::owner(int v) const {
+    return std::upper_bound(bounds_.begin() + 1, bounds_.end() - 1, v) - (bounds_.begin() + 1);
+}
+
+size_t NumaBFS::ranks(size_t node) const {
+    const size_t N = slices_.size();
+    const size_t T = pool_->size();
+    return T / N + (node < T % N ? 1 : 0);
+}
+
+void NumaBFS::run(int source, std::vector<std::atomic<int>>& dist) {
+    const size_t N = slices_.size();
+    const size_t T = pool_->size();
+    if (source < 0 || source >= bounds_[N]) throw std::out_of_range("Source vertex out of range");
+
+    std::vector<size_t> frontier_sizes(N, 0);
+
+    pool_->run([&](size_t w) {
+        const size_t n = node_of(w);
+        const size_t r = rank_of(w);
+        const size_t R = ranks(n);
+        Slice& s = slices_[n];
+        const size_t owned = s.last - s.first;
+
+        for (size_t i = owned * r / R; i < owned * (r + 1) / R; ++i) {
+            s.dist[i].store(INT_MAX, std::memory_order_relaxed);
+        }
+        pool_->barrier();
+
+        if (r == 0) {
+            s.frontier.clear();
+            if (owner(source) == n) {
+                s.dist[source - s.first].store(0, std::memory_order_relaxed);
+                s.frontier.push_back(source);
+            }
+        }
+        pool_->barrier();
+
+        std::vector<int>& next = local_next_[w];
+        std::vector<std::vector<int>>& out = outbox_[w];
+
+        for (int level = 0; ; ++level) {
+            next.clear();
+            for (auto& box : out) box.clear();
+
+            // Expand this node's frontier share; only owned distances are touched
+            const size_t F = s.frontier.size();
+            for (size_t i = F * r / R; i < F * (r + 1) / R; ++i) {
+                const int lu = s.frontier[i] - s.first;
+                for (int e = s.offsets[lu]; e < s.offsets[lu + 1]; ++e) {
+                    const int v = s.edges[e];
+                    if (v >= s.first && v < s.last) {
+                        int expected = INT_MAX;
+                        if (s.dist[v - s.first].compare_exchange_strong(expected, level + 1)) {
+                            next.push_back(v);
+                        }
+                    } else {
+                        out[owner(v)].push_back(v);
+                    }
+                }
+            }
+            pool_->barrier();
+
+            // Drain the mailboxes addressed to this node
+            for (size_t t = r; t < T; t += R) {
+                for (int v : outbox_[t][n]) {
+                    int expected = INT_MAX;
+                    if (s.dist[v - s.first].compare_exchange_strong(expected, level + 1)) {
+                        next.push_back(v);
+                    }
+                }
+            }
+            pool_->barrier();
+
+            if (r == 0) {
+                s.frontier.clear();
+                for (size_t t = n; t < T; t += N) {
+                    s.frontier.insert(s.frontier.end(), local_next_[t].begin(), local_next_[t].end());
+                }
+                frontier_sizes[n] = s.frontier.size();
+            }
+            pool_->barrier();
+
+            size_t total = 0;
+            for (size_t size : frontier_sizes) total += size;
+            if (total == 0) break;
+        }
+
+        for (size_t i = owned * r / R; i < owned * (r + 1) / R; ++i) {
+            dist[s.first + i].store(s.dist[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    });
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,69 @@
+#include "parallel_backend.h"
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace Parallel {
+
+#if defined(BFS_BACKEND_OPENMP)
+
+const char* backend_name() { return "openmp"; }
+
+size_t max_threads() { return static_cast<size_t>(omp_get_max_threads()); }
+
+void set_num_threads(size_t threads) { omp_set_num_threads(static_cast<int>(std::max<size_t>(1, threads))); }
+
+#elif defined(BFS_BACKEND_THREADS)
+
+namespace {
+
+// BFS_NUM_THREADS plays the role of OMP_NUM_THREADS for this backend
+size_t default_threads() {
+    if (const char* env = std::getenv("BFS_NUM_THREADS")) {
+        try {
+            return std::max<size_t>(1, std::stoul(env));
+        } catch (...) {
+        }
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::unique_ptr<ThreadPool>& pool_slot() {
+    static std::unique_ptr<ThreadPool> pool(new ThreadPool(default_threads()));
+    return pool;
+}
+
+} // namespace
+
+namespace detail {
+
+ThreadPool& pool() { return *pool_slot(); }
+
+bool& nested() {
+    thread_local bool inside = false;
+    return inside;
+}
+
+} // namespace detail
+
+const char* backend_name() { return "threads"; }
+
+size_t max_threads() { return pool_slot()->size(); }
+
+void set_num_threads(size_t threads) {
+    threads = std::max<size_t>(1, threads);
+    if (threads != pool_slot()->size()) pool_slot().reset(new ThreadPool(threads));
+}
+
+#else
+
+const char* backend_name() { return "serial"; }
+
+size_t max_threads() { return 1; }
+
+void set_num_threads(size_t) {}
+
+#endif
+
+} // namespace Parallel
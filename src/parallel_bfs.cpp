@@ -1,14 +1,20 @@
 #include "parallel_bfs.h"
+#include "thread_pool.h"
+#include "workspace.h"
+#include "parallel_backend.h"
 #include <iostream>
 #include <fstream>
-#include <omp.h>
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <unordered_map>
 #include <queue>
 #include <stdexcept>
 #include <unordered_set>
 #include <mutex> // Include mutex for thread safety
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 
 // Graph member function implementations
 std::vector<int> Graph::neighbors(int u) const {
@@ -18,94 +24,409 @@ std::vector<int> Graph::neighbors(int u) const {
     return {edges.begin() + offsets[u], edges.begin() + offsets[u+1]};
 }
 
+namespace {
+
+// Offsets ascend from 0 to edges.size()
+bool is_csr(const std::vector<int>& offsets, const std::vector<int>& edges) {
+    if (offsets.size() < 2 || offsets.front() != 0 || static_cast<size_t>(offsets.back()) != edges.size()) return false;
+    const size_t bad_offsets = Parallel::sum<size_t>(offsets.size() - 1, [&](size_t u) {
+        return offsets[u] > offsets[u + 1] ? 1 : 0;
+    }, 4096);
+    return bad_offsets == 0;
+}
+
+} // namespace
+
+bool Graph::validate() const {
+    const size_t V = vertex_count();
+    if (!is_csr(offsets, edges)) return false;
+    if (weighted() && weights.size() != edges.size()) return false;
+    const size_t bad_targets = Parallel::sum<size_t>(edges.size(), [&](size_t e) {
+        return edges[e] < 0 || static_cast<size_t>(edges[e]) >= V ? 1 : 0;
+    }, 4096);
+    return bad_targets == 0;
+}
+
+int GraphMetadata::hub_threshold(size_t vertices, size_t edges) {
+    const double mean = static_cast<double>(edges) / std::max<size_t>(1, vertices);
+    return static_cast<int>(std::min<double>(INT_MAX, std::max<double>(HUB_MIN_DEGREE, HUB_DEGREE_FACTOR * mean)));
+}
+
+GraphMetadata GraphMetadata::degrees(const std::vector<int>& offsets, const std::vector<int>& edges) {
+    GraphMetadata meta;
+    if (!is_csr(offsets, edges)) return meta;
+
+    const size_t V = offsets.size() - 1;
+    meta.hub_degree = hub_threshold(V, edges.size());
+
+    struct Partial {
+        int max_degree = 0;
+        std::vector<size_t> histogram = std::vector<size_t>(HISTOGRAM_BUCKETS, 0);
+        std::vector<int> hubs;
+    };
+    Parallel::PerThread<Partial> partials;
+
+    Parallel::for_chunks(V, 1024, [&](size_t begin, size_t end, size_t thread) {
+        Partial& p = partials[thread];
+        for (size_t u = begin; u < end; ++u) {
+            const int degree = offsets[u + 1] - offsets[u];
+            p.max_degree = std::max(p.max_degree, degree);
+            p.histogram[degree_bucket(degree)]++;
+            if (degree >= meta.hub_degree) p.hubs.push_back(static_cast<int>(u));
+        }
+    });
+
+    std::vector<size_t> histogram(HISTOGRAM_BUCKETS, 0);
+    partials.for_each([&](Partial& p) {
+        meta.max_degree = std::max(meta.max_degree, p.max_degree);
+        for (size_t k = 0; k < histogram.size(); ++k) histogram[k] += p.histogram[k];
+        meta.hubs.insert(meta.hubs.end(), p.hubs.begin(), p.hubs.end());
+    });
+    meta.degree_histogram.assign(histogram.begin(), histogram.begin() + degree_bucket(meta.max_degree) + 1);
+    std::sort(meta.hubs.begin(), meta.hubs.end());
+    return meta;
+}
+
+GraphMetadata GraphMetadata::compute(const std::vector<int>& offsets, const std::vector<int>& edges) {
+    GraphMetadata meta = degrees(offsets, edges);
+    if (!is_csr(offsets, edges)) return meta;
+
+    const size_t V = offsets.size() - 1;
+    std::atomic<bool> symmetric{true};
+    Parallel::for_chunks(V, 256, [&](size_t begin, size_t end, size_t) {
+        bool mirrored = symmetric.load(std::memory_order_relaxed);
+        for (size_t u = begin; mirrored && u < end; ++u) {
+            // binary_search on an unsorted list of v may miss u but never
+            // invents it, and whoever scans v itself finds it unsorted: a
+            // false "no" is possible there, a false "yes" is not
+            for (int e = offsets[u]; mirrored && e < offsets[u + 1]; ++e) {
+                const int v = edges[e];
+                mirrored = v >= 0 && static_cast<size_t>(v) < V && (e == offsets[u] || edges[e - 1] <= v) &&
+                           std::binary_search(edges.begin() + offsets[v], edges.begin() + offsets[v + 1], static_cast<int>(u));
+            }
+        }
+        if (!mirrored) symmetric.store(false, std::memory_order_relaxed);
+    });
+    meta.symmetric = symmetric.load();
+    return meta;
+}
+
+const GraphMetadata& Graph::metadata() const {
+    std::shared_ptr<const GraphMetadata> meta = std::atomic_load(&metadata_);
+    if (!meta) {
+        // Racing first callers each compute it; the first to publish wins
+        std::shared_ptr<const GraphMetadata> computed = std::make_shared<const GraphMetadata>(GraphMetadata::compute(offsets, edges));
+        if (std::atomic_compare_exchange_strong(&metadata_, &meta, computed)) meta = std::move(computed);
+    }
+    return *meta;
+}
+
+void Graph::set_metadata(GraphMetadata meta) {
+    std::atomic_store(&metadata_, std::shared_ptr<const GraphMetadata>(std::make_shared<const GraphMetadata>(std::move(meta))));
+}
+
+namespace {
+
+// Parses one "u v [w]" edge-list line. Returns the number of columns read,
+// 0 for blank and comment lines, -1 for malformed lines (including extra
+// columns), -2 for vertex IDs that do not fit in an int and -3 for weights
+// that are negative, infinite or NaN.
+int parse_edge_line(const std::string& line, int& u, int& v, float& w) {
+    const char* p = line.c_str();
+    while (*p == ' ' || *p == '\t') ++p;
+    if (*p == '\0' || *p == '\r' || *p == '#' || *p == '%') return 0;
+
+    char* end;
+    const long a = std::strtol(p, &end, 10);
+    if (end == p || (*end != ' ' && *end != '\t')) return -1;
+    p = end;
+    const long b = std::strtol(p, &end, 10);
+    if (end == p) return -1;
+    p = end;
+    if (a < 0 || b < 0) return -1;
+    if (a >= INT_MAX || b >= INT_MAX) return -2;  // V = max ID + 1 must fit too
+    u = static_cast<int>(a);
+    v = static_cast<int>(b);
+
+    int cols = 2;
+    while (*p == ' ' || *p == '\t') ++p;
+    if (*p != '\0' && *p != '\r') {
+        w = std::strtof(p, &end);
+        if (end == p) return -1;
+        if (!(w >= 0) || !std::isfinite(w)) return -3;
+        p = end;
+        cols = 3;
+        while (*p == ' ' || *p == '\t') ++p;
+    }
+    return *p == '\0' || *p == '\r' ? cols : -1;
+}
+
+} // namespace
+
 Graph GraphGenerator::from_file(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Could not open file: " + filename);
 
-    // First pass: count edges and find max vertex ID
+    // First pass: out-degree of u accumulates in offsets[u + 1]; every line must have the column count of the first
+    std::vector<int> offsets(1, 0);
     size_t edge_count = 0;
     int max_vertex = 0;
+    int columns = 0;
     int u, v;
-    while (file >> u >> v) {
-        edge_count++;
+    float w = 1.0f;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(file, line)) {
+        ++line_no;
+        const int cols = parse_edge_line(line, u, v, w);
+        if (cols == 0) continue;
+        const std::string where = " on line " + std::to_string(line_no) + " of " + filename;
+        if (cols == -2) throw std::runtime_error("Vertex ID" + where + " does not fit in an int");
+        if (cols == -3) throw std::runtime_error("Edge weight" + where + " is not a finite non-negative number");
+        if (cols < 0) throw std::runtime_error("Malformed edge" + where);
+        if (columns == 0) columns = cols;
+        if (cols != columns) {
+            throw std::runtime_error(std::to_string(cols) + " columns" + where + ", earlier lines have " +
+                                     std::to_string(columns));
+        }
+        if (++edge_count > static_cast<size_t>(INT_MAX)) throw std::runtime_error(filename + " has more than INT_MAX edges");
+        if (static_cast<size_t>(u) + 2 > offsets.size()) offsets.resize(static_cast<size_t>(u) + 2, 0);
+        offsets[u + 1]++;
         max_vertex = std::max({max_vertex, u, v});
     }
+    const bool weighted = columns == 3;
 
-    // Second pass: build the graph with memory efficiency
+    const size_t V = static_cast<size_t>(max_vertex) + 1;
+    offsets.resize(V + 1, 0);
+    for (size_t i = 1; i <= V; ++i) offsets[i] += offsets[i - 1];
+
+    // Second pass: offsets[u] doubles as u's write cursor, so lines need not be grouped by source
     file.clear();
     file.seekg(0);
-    
-    std::vector<int> offsets(max_vertex + 2, 0); // +2 for 1-based indexing and sentinel
-    std::vector<int> edges;
-    edges.reserve(edge_count);
+    std::vector<int> edges(edge_count);
+    std::vector<float> weights(weighted ? edge_count : 0);
+    size_t placed = 0;
+    while (std::getline(file, line)) {
+        if (parse_edge_line(line, u, v, w) == 0) continue;
+        if (static_cast<size_t>(u) >= V || placed == edge_count) throw std::runtime_error(filename + " changed while loading");
+        const int slot = offsets[u]++;
+        edges[slot] = v;
+        if (weighted) weights[slot] = w;
+        ++placed;
+    }
+    if (placed != edge_count) throw std::runtime_error(filename + " changed while loading");
+
+    // Shift the cursors back into start offsets
+    for (size_t i = V; i > 0; --i) offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+
+    return Graph(std::move(offsets), std::move(edges), std::move(weights));
+}
+
+namespace {
+
+// Binary layout: this header, then offsets (V + 1 int32), edges (E int32),
+// weights (E float, if FLAG_WEIGHTED), the degree histogram (uint64 each) and hubs (int32 each)
+constexpr char BINARY_MAGIC[8] = {'B', 'F', 'S', 'G', 'R', 'A', 'P', 'H'};
+constexpr uint32_t BINARY_VERSION = 1;
+constexpr uint32_t FLAG_WEIGHTED = 1;
+constexpr uint32_t FLAG_SYMMETRIC = 2;
+
+struct BinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t vertices;
+    uint64_t edges;
+    int32_t max_degree;
+    int32_t hub_degree;
+    uint64_t histogram_buckets;
+    uint64_t hub_count;
+};
+
+template <typename T>
+void write_array(std::ofstream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+void read_array(std::ifstream& in, std::vector<T>& values, size_t count, const std::string& filename) {
+    values.resize(count);
+    in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+    if (static_cast<size_t>(in.gcount()) != count * sizeof(T)) throw std::runtime_error("Truncated graph file: " + filename);
+}
+
+} // namespace
 
-    while (file >> u >> v) {
-        offsets[u+1]++; // Count degrees
-        edges.push_back(v);
+void GraphGenerator::save_binary(const Graph& g, const std::string& filename) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("Could not open file: " + filename);
+
+    const GraphMetadata& meta = g.metadata();
+    BinaryHeader header{};
+    std::copy(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC), header.magic);
+    header.version = BINARY_VERSION;
+    header.flags = 0;
+    if (g.weighted()) header.flags |= FLAG_WEIGHTED;
+    if (meta.symmetric) header.flags |= FLAG_SYMMETRIC;
+    header.vertices = g.vertex_count();
+    header.edges = g.edge_count();
+    header.max_degree = meta.max_degree;
+    header.hub_degree = meta.hub_degree;
+    header.histogram_buckets = meta.degree_histogram.size();
+    header.hub_count = meta.hubs.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(out, g.offsets);
+    write_array(out, g.edges);
+    write_array(out, g.weights);
+    std::vector<uint64_t> histogram(meta.degree_histogram.begin(), meta.degree_histogram.end());
+    write_array(out, histogram);
+    write_array(out, meta.hubs);
+    if (!out) throw std::runtime_error("Error writing " + filename);
+}
+
+Graph GraphGenerator::from_binary(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("Could not open file: " + filename);
+
+    BinaryHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (in.gcount() != sizeof(header) || !std::equal(std::begin(BINARY_MAGIC), std::end(BINARY_MAGIC), header.magic)) {
+        throw std::runtime_error("Not a binary graph file: " + filename);
+    }
+    if (header.version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported binary graph version " + std::to_string(header.version) + " in " + filename);
     }
+    if (header.vertices == 0 || header.vertices >= INT_MAX || header.edges > INT_MAX || header.histogram_buckets > GraphMetadata::HISTOGRAM_BUCKETS ||
+        header.hub_count > header.vertices) {
+        throw std::runtime_error("Corrupt binary graph header in " + filename);
+    }
+
+    std::vector<int> offsets, edges, hubs;
+    std::vector<float> weights;
+    std::vector<uint64_t> histogram;
+    read_array(in, offsets, header.vertices + 1, filename);
+    read_array(in, edges, header.edges, filename);
+    if (header.flags & FLAG_WEIGHTED) read_array(in, weights, header.edges, filename);
+    read_array(in, histogram, header.histogram_buckets, filename);
+    read_array(in, hubs, header.hub_count, filename);
 
-    // Prefix sum to get offsets
-    for (size_t i = 1; i < offsets.size(); ++i) {
-        offsets[i] += offsets[i-1];
+    Graph g(std::move(offsets), std::move(edges), std::move(weights));
+    if (!g.validate()) throw std::runtime_error("Corrupt graph in " + filename);
+
+    // Degree facts are rechecked in O(V), which also range-checks the hubs.
+    // A set symmetric flag would let engines skip their transposes, so it is
+    // confirmed by the symmetry pass; a clear one is safe to take as is
+    const bool symmetric = (header.flags & FLAG_SYMMETRIC) != 0;
+    GraphMetadata meta = symmetric ? GraphMetadata::compute(g.offsets, g.edges) : GraphMetadata::degrees(g.offsets, g.edges);
+    if (meta.max_degree != header.max_degree || meta.hub_degree != header.hub_degree || meta.hubs != hubs ||
+        !std::equal(meta.degree_histogram.begin(), meta.degree_histogram.end(), histogram.begin(), histogram.end())) {
+        throw std::runtime_error("Stale or corrupt metadata in " + filename);
     }
+    if (meta.symmetric != symmetric) throw std::runtime_error("Stale symmetric flag in " + filename);
 
-    return Graph(std::move(offsets), std::move(edges));
+    g.set_metadata(std::move(meta));
+    return g;
 }
 // Parallel BFS implementations
 namespace ParallelBFS {
 
-void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist) {
+namespace {
+
+// Expands frontier [first, last) to `level + 1`, calling discover(v) for every
+// vertex it claims. With Prefetch the loads run as a pipeline `distance` ahead
+// of the vertex being expanded, so the random dist[] lines are in flight before
+// the CAS. Without it the loop is the plain CAS scan, with no per-edge test.
+template <bool Prefetch, typename Discover>
+void expand_range(const Graph& g, const int* first, const int* last, int level,
+                  std::vector<std::atomic<int>>& dist, int distance, Discover&& discover) {
+    const int* offsets = g.offsets.data();
+    const int* edges = g.edges.data();
+    const ptrdiff_t far = distance;
+    const ptrdiff_t near = std::max(1, distance / 2);
+
+    for (const int* it = first; it != last; ++it) {
+        const int u = *it;
+        const int begin = offsets[u];
+        const int end = offsets[u + 1];
+
+        if constexpr (Prefetch) {
+            const ptrdiff_t ahead = last - it;
+            if (ahead > far) __builtin_prefetch(offsets + it[far]);
+            if (ahead > near) __builtin_prefetch(edges + offsets[it[near]]);
+            // First `distance` neighbors of the next vertex; the rest are covered below
+            if (ahead > 1) {
+                const int w = it[1];
+                const int stop = std::min(offsets[w + 1], offsets[w] + distance);
+                for (int e = offsets[w]; e < stop; ++e) __builtin_prefetch(&dist[edges[e]], 1);
+            }
+        }
+
+        for (int e = begin; e < end; ++e) {
+            if constexpr (Prefetch) {
+                if (e + distance < end) __builtin_prefetch(&dist[edges[e + distance]], 1);
+            }
+            const int v = edges[e];
+            int expected = INT_MAX;
+            if (dist[v].compare_exchange_strong(expected, level + 1)) discover(v);
+        }
+    }
+}
+
+// Picks the instantiation once per range instead of testing on every edge
+template <typename Discover>
+void expand_prefetched(const Graph& g, const int* first, const int* last, int level,
+                       std::vector<std::atomic<int>>& dist, int distance, Discover&& discover) {
+    if (distance > 0) {
+        expand_range<true>(g, first, last, level, dist, distance, discover);
+    } else {
+        expand_range<false>(g, first, last, level, dist, distance, discover);
+    }
+}
+
+} // namespace
+
+void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist, int prefetch_distance) {
     const size_t V = g.vertex_count();
     
     // Initialize distances
-    #pragma omp parallel for
-    for (size_t i = 0; i < V; ++i) {
+    Parallel::parallel_for(V, [&](size_t i) {
         dist[i].store(INT_MAX);
-    }
+    });
     dist[source].store(0);
     
-    std::vector<int> current_frontier = {source};
-    std::atomic<size_t> total_visited{1};
+    // Discoveries go straight into per-thread chunks; no critical append, sort or copy per level.
+    // The bags' chunks come back with the workspace, so repeated queries reuse them.
+    Workspace::Lease workspace(Parallel::max_threads());
+    FrontierBag* current_frontier = &workspace->bag(0);
+    FrontierBag* next_frontier = &workspace->bag(1);
+    current_frontier->insert(0, source);
+    current_frontier->seal();
+
+    size_t total_visited = 1;
     int iteration = 0;
     
-    while (!current_frontier.empty()) {
-        std::vector<int> next_frontier;
-        next_frontier.reserve(current_frontier.size() * g.avg_degree);
+    while (!current_frontier->empty()) {
+        const std::vector<FrontierBag::Range>& ranges = current_frontier->ranges();
         
-        #pragma omp parallel
-        {
-            std::vector<int> private_next;
-            #pragma omp for nowait
-            for (size_t i = 0; i < current_frontier.size(); ++i) {
-                int u = current_frontier[i];
-                int current_dist = dist[u].load();
-                
-                for (int v : g.neighbors(u)) {
-                    int expected = INT_MAX;
-                    if (dist[v].compare_exchange_strong(expected, current_dist + 1)) {
-                        private_next.push_back(v);
-                        total_visited++; // Increment using atomic<size_t>
-                    }
-                }
+        Parallel::for_chunks(ranges.size(), 1, [&](size_t first, size_t last, size_t tid) {
+            for (size_t r = first; r < last; ++r) {
+                expand_prefetched(g, ranges[r].begin, ranges[r].end, iteration, dist, prefetch_distance,
+                                  [&](int v) { next_frontier->insert(tid, v); });
             }
-            
-            #pragma omp critical
-            next_frontier.insert(next_frontier.end(), private_next.begin(), private_next.end());
-        }
+        });
         
-        // Remove duplicates efficiently
-        if (!next_frontier.empty()) {
-            std::sort(next_frontier.begin(), next_frontier.end());
-            next_frontier.erase(std::unique(next_frontier.begin(), next_frontier.end()), next_frontier.end());
-        }
-        
-        current_frontier = std::move(next_frontier);
+        next_frontier->seal();
+        total_visited += next_frontier->size();
+        current_frontier->clear();
+        std::swap(current_frontier, next_frontier);
         iteration++;
         
         // Progress reporting
         if (iteration % 10 == 0) {
             std::cout << "Iteration " << iteration 
-                      << ": Frontier=" << current_frontier.size()
+                      << ": Frontier=" << current_frontier->size()
                       << ", Visited=" << total_visited << "\n";
         }
     }
@@ -113,6 +434,48 @@ void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist)
     std::cout << "BFS completed in " << iteration << " iterations. "
               << "Total vertices visited: " << total_visited << "\n";
 }
+
+void optimized(const Graph& g, int source, std::vector<std::atomic<int>>& dist, ThreadPool& pool,
+               int prefetch_distance) {
+    const size_t V = g.vertex_count();
+    const size_t T = pool.size();
+
+    // Double-buffered frontier indexed by level parity, so no worker has to swap
+    Workspace::Lease workspace(T);
+    workspace->frontier(0).assign(1, source);
+    std::vector<size_t> offsets(T + 1, 0);
+
+    pool.run([&](size_t w) {
+        pool.for_each(w, V, 4096, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) dist[i].store(INT_MAX, std::memory_order_relaxed);
+        });
+        if (w == 0) dist[source].store(0);
+        pool.barrier();
+
+        for (int level = 0; ; ++level) {
+            const std::vector<int>& current_frontier = workspace->frontier(level);
+            std::vector<int>& next_frontier = workspace->frontier(level + 1);
+            std::vector<int>& mine = workspace->local(w);
+            mine.clear();
+
+            pool.for_each(w, current_frontier.size(), 64, [&](size_t begin, size_t end, size_t) {
+                expand_prefetched(g, current_frontier.data() + begin, current_frontier.data() + end, level,
+                                  dist, prefetch_distance, [&](int v) { mine.push_back(v); });
+            });
+
+            // Worker 0 sizes the next frontier; everyone then copies its share in place
+            if (w == 0) {
+                for (size_t t = 0; t < T; ++t) offsets[t + 1] = offsets[t] + workspace->local(t).size();
+                next_frontier.resize(offsets[T]);
+            }
+            pool.barrier();
+            if (offsets[T] == 0) break;
+
+            std::copy(mine.begin(), mine.end(), next_frontier.begin() + offsets[w]);
+            pool.barrier();
+        }
+    });
+}
     
 
 void baseline(const Graph& g, int source, std::vector<std::atomic<int>>& dist) {
@@ -135,73 +498,113 @@ void baseline(const Graph& g, int source, std::vector<std::atomic<int>>& dist) {
     }
 }
 
-bool validate_result(const Graph& g, int source, const std::vector<std::atomic<int>>& dist) {
-    std::vector<std::atomic<int>> reference(dist.size());
-    baseline(g, source, reference);
-    
-    for (size_t i = 0; i < dist.size(); ++i) {
-        if (dist[i].load() != reference[i].load()) {
-            std::cerr << "Validation failed at vertex " << i 
-                      << ": expected " << reference[i].load() 
-                      << ", got " << dist[i].load() << "\n";
-            return false;
+namespace {
+
+// Graph500-style check of a BFS level array against its own invariants, with
+// no reference traversal: three parallel O(V + E) passes. Together they pin
+// every level to the true hop distance. A predecessor chain bounds each level
+// from below; the edge rule bounds it from above and rules out reached
+// vertices next to unreached ones.
+template <typename Level>
+bool check_levels(const Graph& g, int source, Level&& level) {
+    const size_t V = g.vertex_count();
+    constexpr size_t NONE = SIZE_MAX;
+    auto first = [](size_t a, size_t b) { return std::min(a, b); };
+    auto fail = [](const std::string& why) {
+        std::cerr << "Validation failed: " << why << "\n";
+        return false;
+    };
+
+    if (source < 0 || static_cast<size_t>(source) >= V) return fail("source " + std::to_string(source) + " out of range");
+    if (level(source) != 0) return fail("source " + std::to_string(source) + " at level " + std::to_string(level(source)));
+
+    // Levels are INT_MAX or in [0, V), and only the source sits at 0
+    size_t bad = Parallel::reduce(V, NONE, [&](size_t v) {
+        const int d = level(v);
+        const bool ok = d == INT_MAX || (d >= 0 && static_cast<size_t>(d) < V && (d > 0 || v == static_cast<size_t>(source)));
+        return ok ? NONE : v;
+    }, first, 4096);
+    if (bad != NONE) return fail("vertex " + std::to_string(bad) + " at level " + std::to_string(level(bad)));
+
+    // An edge out of a reached vertex spans at most one level down, and every
+    // edge that spans exactly one records its head as having a predecessor
+    std::vector<std::atomic<uint64_t>> has_parent((V + 63) / 64);
+    Parallel::parallel_for(has_parent.size(), [&](size_t w) { has_parent[w].store(0, std::memory_order_relaxed); });
+
+    bad = Parallel::reduce(V, NONE, [&](size_t u) {
+        const int du = level(u);
+        if (du == INT_MAX) return NONE;
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            const int v = g.edges[e];
+            const int dv = level(v);
+            if (dv > du + 1) return u;  // Includes unreached heads
+            if (dv == du + 1) {
+                std::atomic<uint64_t>& word = has_parent[v / 64];
+                const uint64_t bit = uint64_t(1) << (v % 64);
+                if (!(word.load(std::memory_order_relaxed) & bit)) word.fetch_or(bit, std::memory_order_relaxed);
+            }
+        }
+        return NONE;
+    }, first, 256);
+    if (bad != NONE) {
+        const int du = level(bad);
+        for (int e = g.offsets[bad]; e < g.offsets[bad + 1]; ++e) {
+            const int dv = level(g.edges[e]);
+            if (dv > du + 1) {
+                return fail("edge " + std::to_string(bad) + " -> " + std::to_string(g.edges[e]) + " spans levels " +
+                            std::to_string(du) + " -> " + (dv == INT_MAX ? std::string("unreached") : std::to_string(dv)));
+            }
         }
     }
-    return true;
-}
 
-std::vector<int> get_distances(const std::vector<std::atomic<int>>& dist) {
-    std::vector<int> result(dist.size());
-    for (size_t i = 0; i < dist.size(); ++i) {
-        result[i] = dist[i].load();
+    // Every reached vertex but the source hangs off one a level above
+    bad = Parallel::reduce(V, NONE, [&](size_t v) {
+        const bool orphan = level(v) != INT_MAX && v != static_cast<size_t>(source) &&
+                            !(has_parent[v / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (v % 64)));
+        return orphan ? v : NONE;
+    }, first, 4096);
+    if (bad != NONE) {
+        return fail("vertex " + std::to_string(bad) + " at level " + std::to_string(level(bad)) +
+                    " has no predecessor at level " + std::to_string(level(bad) - 1));
     }
-    return result;
+    return true;
 }
 
-void validate_graph_structure(const Graph& g) {
-    std::cout << "\nGraph Structure Validation:\n";
-    size_t total_edges = 0;
-    size_t min_edges = SIZE_MAX;
-    size_t max_edges = 0;
-    size_t isolated_vertices = 0;
+} // namespace
 
-    for (size_t i = 0; i < g.vertex_count(); i++) {
-        size_t degree = g.neighbors(i).size();
-        total_edges += degree;
-        min_edges = std::min(min_edges, degree);
-        max_edges = std::max(max_edges, degree);
-        if (degree == 0) isolated_vertices++;
+bool validate_result(const Graph& g, int source, const std::vector<std::atomic<int>>& dist) {
+    if (dist.size() != g.vertex_count()) {
+        std::cerr << "Validation failed: " << dist.size() << " distances for " << g.vertex_count() << " vertices\n";
+        return false;
     }
+    return check_levels(g, source, [&](size_t v) { return dist[v].load(std::memory_order_relaxed); });
+}
 
-    std::cout << "Total edges (directed count): " << total_edges << "\n";
-    std::cout << "Min degree: " << min_edges << "\n";
-    std::cout << "Max degree: " << max_edges << "\n";
-    std::cout << "Isolated vertices: " << isolated_vertices << "\n";
-    std::cout << "Average degree: " << static_cast<double>(total_edges) / g.vertex_count() << "\n";
+bool validate_result(const Graph& g, int source, const std::vector<int>& dist) {
+    if (dist.size() != g.vertex_count()) {
+        std::cerr << "Validation failed: " << dist.size() << " distances for " << g.vertex_count() << " vertices\n";
+        return false;
+    }
+    return check_levels(g, source, [&](size_t v) { return dist[v]; });
+}
 
-    // Verify edge targets are valid
-    size_t invalid_edges = 0;
-    for (size_t u = 0; u < std::min(g.vertex_count(), static_cast<size_t>(1000)); u++) {
-        for (int v : g.neighbors(u)) {
-            if (v < 0 || v >= static_cast<int>(g.vertex_count())) {
-                invalid_edges++;
-            }
-        }
+std::vector<int> get_distances(const std::vector<std::atomic<int>>& dist) {
+    std::vector<int> result(dist.size());
+    for (size_t i = 0; i < dist.size(); ++i) {
+        result[i] = dist[i].load();
     }
-    std::cout << "Invalid edge targets found: " << invalid_edges << "\n";
+    return result;
 }
 
 void optimized_multi_source(const Graph& g, std::vector<std::atomic<int>>& dist) {
     const size_t V = g.vertex_count();
     std::atomic<size_t> total_visited{0};
     
-    #pragma omp parallel
-    {
+    Parallel::region([&](size_t thread, size_t threads) {
         std::vector<int> local_sources;
         
         // First find all potential sources in parallel
-        #pragma omp for schedule(static)
-        for (size_t i = 0; i < V; ++i) {
+        for (size_t i = V * thread / threads; i < V * (thread + 1) / threads; ++i) {
             if (dist[i].load() == INT_MAX && !g.neighbors(i).empty()) {
                 local_sources.push_back(i);
             }
@@ -232,7 +635,7 @@ void optimized_multi_source(const Graph& g, std::vector<std::atomic<int>>& dist)
                 total_visited.fetch_add(local_visited, std::memory_order_relaxed);
             }
         }
-    }
+    });
     
     std::cout << "BFS completed. Total vertices visited: " << total_visited.load() << "\n";
 }
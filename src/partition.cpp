@@ -0,0 +1,222 @@
+#include "partition.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+namespace {
+
+void initial_split(const Graph& g, const PartitionConfig& config, std::vector<int>& part) {
+    const size_t V = g.vertex_count();
+    const size_t E = g.edge_count();
+    const long long parts = config.parts;
+
+    if (config.initial == InitialSplit::Block) {
+        // Vertex v goes wherever its first edge falls in an even split of the edge array
+        Parallel::parallel_for(V, [&](size_t v) {
+            long long p = E > 0 ? static_cast<long long>(g.offsets[v]) * parts / static_cast<long long>(E)
+                                : static_cast<long long>(v) * parts / static_cast<long long>(V);
+            part[v] = static_cast<int>(std::min(p, parts - 1));
+        });
+        return;
+    }
+
+    // Largest degrees first, each to the currently lightest partition
+    std::vector<int> by_degree(V);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) {
+        return g.offsets[a + 1] - g.offsets[a] > g.offsets[b + 1] - g.offsets[b];
+    });
+
+    using Load = std::pair<size_t, int>; // (edges, partition)
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> lightest;
+    for (int p = 0; p < config.parts; ++p) lightest.push({0, p});
+
+    for (int v : by_degree) {
+        Load top = lightest.top();
+        lightest.pop();
+        part[v] = top.second;
+        // Count the vertex itself so isolated vertices still spread out
+        top.first += static_cast<size_t>(g.offsets[v + 1] - g.offsets[v]) + 1;
+        lightest.push(top);
+    }
+}
+
+} // namespace
+
+Partition partition(const Graph& g, const PartitionConfig& config) {
+    if (config.parts < 1) throw std::invalid_argument("Partition count must be positive");
+
+    const size_t V = g.vertex_count();
+    const size_t E = g.edge_count();
+    const int parts = config.parts;
+
+    Partition result;
+    result.part.resize(V);
+    initial_split(g, config, result.part);
+
+    std::vector<std::atomic<long long>> load(parts);
+    for (auto& l : load) l.store(0);
+    Parallel::parallel_for(V, [&](size_t v) {
+        load[result.part[v]].fetch_add(g.offsets[v + 1] - g.offsets[v], std::memory_order_relaxed);
+    });
+
+    const long long capacity = static_cast<long long>(config.max_imbalance * ((E + parts - 1) / parts));
+    std::vector<int> next_part = result.part;
+    size_t previous_moves = 1;
+
+    for (int round = 0; round < config.refinement_rounds; ++round) {
+        // Alternating the allowed direction keeps neighbors from swapping places forever
+        const bool upward = (round % 2 == 0);
+        struct Scratch {
+            std::vector<int> count;
+            std::vector<int> touched;
+            size_t moves = 0;
+        };
+        Parallel::PerThread<Scratch> scratch;
+
+        Parallel::for_chunks(V, 1024, [&](size_t begin, size_t end, size_t thread) {
+            Scratch& local = scratch[thread];
+            std::vector<int>& count = local.count;
+            std::vector<int>& touched = local.touched;
+            if (count.empty()) count.assign(parts, 0);
+
+            for (size_t v = begin; v < end; ++v) {
+                const long long degree = g.offsets[v + 1] - g.offsets[v];
+                if (degree == 0) continue;
+
+                const int current = result.part[v];
+                touched.clear();
+                for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    const int p = result.part[g.edges[e]];
+                    if (count[p]++ == 0) touched.push_back(p);
+                }
+
+                int best = current;
+                for (int p : touched) {
+                    if ((upward ? p > current : p < current) &&
+                        (count[p] > count[best] || (count[p] == count[best] && best != current && p < best))) {
+                        best = p;
+                    }
+                }
+                for (int p : touched) count[p] = 0;
+                if (best == current) continue;
+
+                // Reserve room in the target before committing the move
+                if (load[best].fetch_add(degree, std::memory_order_relaxed) + degree <= capacity) {
+                    load[current].fetch_sub(degree, std::memory_order_relaxed);
+                    next_part[v] = best;
+                    local.moves++;
+                } else {
+                    load[best].fetch_sub(degree, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        size_t moves = 0;
+        scratch.for_each([&](const Scratch& local) { moves += local.moves; });
+
+        if (moves > 0) {
+            Parallel::parallel_for(V, [&](size_t v) { result.part[v] = next_part[v]; });
+        }
+        if (moves == 0 && previous_moves == 0) break;
+        previous_moves = moves;
+    }
+
+    // Partition-contiguous relabeling that keeps the original order inside each partition
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(V, 256));
+    std::vector<int> chunk_counts(chunks * parts, 0);
+
+    Parallel::parallel_for(chunks, [&](size_t c) {
+        for (size_t v = V * c / chunks; v < V * (c + 1) / chunks; ++v) {
+            chunk_counts[c * parts + result.part[v]]++;
+        }
+    });
+
+    result.part_offsets.assign(parts + 1, 0);
+    std::vector<int> chunk_start(chunks * parts);
+    int next_id = 0;
+    for (int p = 0; p < parts; ++p) {
+        result.part_offsets[p] = next_id;
+        for (size_t c = 0; c < chunks; ++c) {
+            chunk_start[c * parts + p] = next_id;
+            next_id += chunk_counts[c * parts + p];
+        }
+    }
+    result.part_offsets[parts] = next_id;
+
+    result.new_id.resize(V);
+    Parallel::parallel_for(chunks, [&](size_t c) {
+        int* cursor = &chunk_start[c * parts];
+        for (size_t v = V * c / chunks; v < V * (c + 1) / chunks; ++v) {
+            result.new_id[v] = cursor[result.part[v]]++;
+        }
+    });
+
+    // Quality report
+    result.edge_cut = Parallel::sum<size_t>(V, [&](size_t v) {
+        size_t cut = 0;
+        for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            if (result.part[g.edges[e]] != result.part[v]) cut++;
+        }
+        return cut;
+    }, 1024);
+
+    result.part_edges.resize(parts);
+    size_t heaviest = 0;
+    for (int p = 0; p < parts; ++p) {
+        result.part_edges[p] = static_cast<size_t>(load[p].load());
+        heaviest = std::max(heaviest, result.part_edges[p]);
+    }
+    result.imbalance = E > 0 ? heaviest / (static_cast<double>(E) / parts) : 1.0;
+    return result;
+}
+
+Graph relabel(const Graph& g, const std::vector<int>& new_id) {
+    const size_t V = g.vertex_count();
+    if (new_id.size() != V) throw std::invalid_argument("Relabeling must cover every vertex");
+
+    const size_t out_of_range = Parallel::sum<size_t>(V, [&](size_t v) {
+        return new_id[v] < 0 || static_cast<size_t>(new_id[v]) >= V ? 1 : 0;
+    }, 4096);
+    if (out_of_range > 0) throw std::invalid_argument("Relabeling maps vertices outside [0, V)");
+
+    // Every ID claimed once before any is written through
+    std::vector<std::atomic<uint64_t>> claimed((V + 63) / 64);
+    Parallel::parallel_for(claimed.size(), [&](size_t w) { claimed[w].store(0, std::memory_order_relaxed); });
+    const size_t repeats = Parallel::sum<size_t>(V, [&](size_t v) {
+        const uint64_t bit = uint64_t(1) << (new_id[v] % 64);
+        return claimed[new_id[v] / 64].fetch_or(bit, std::memory_order_relaxed) & bit ? 1 : 0;
+    }, 4096);
+    if (repeats > 0) throw std::invalid_argument("Relabeling is not a permutation");
+
+    std::vector<int> old_id(V);
+    Parallel::parallel_for(V, [&](size_t v) { old_id[new_id[v]] = static_cast<int>(v); });
+
+    std::vector<int> offsets(V + 1, 0);
+    for (size_t n = 0; n < V; ++n) {
+        offsets[n + 1] = offsets[n] + (g.offsets[old_id[n] + 1] - g.offsets[old_id[n]]);
+    }
+
+    std::vector<int> edges(g.edge_count());
+    std::vector<float> weights(g.weighted() ? g.edge_count() : 0);
+
+    Parallel::parallel_for(V, [&](size_t n) {
+        const int u = old_id[n];
+        int out = offsets[n];
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e, ++out) {
+            edges[out] = new_id[g.edges[e]];
+            if (g.weighted()) weights[out] = g.weights[e];
+        }
+    }, 1024);
+
+    return Graph(std::move(offsets), std::move(edges), std::move(weights));
+}
+
+} // namespace ParallelBFS
@@ -0,0 +1,275 @@
+#include "simd_kernels.h"
+#include <cstdlib>
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BFS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Kernels {
+
+namespace {
+
+// Scalar fallbacks
+
+template <typename Id>
+size_t first_in_bitmap_scalar(const Id* ids, size_t n, const uint64_t* bitmap) {
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t v = static_cast<uint32_t>(ids[i]);
+        if (bitmap[v >> 6] & (uint64_t(1) << (v & 63))) return i;
+    }
+    return n;
+}
+
+size_t popcount_scalar(const uint64_t* words, size_t first_word, size_t last_word) {
+    size_t count = 0;
+    for (size_t w = first_word; w < last_word; ++w) count += __builtin_popcountll(words[w]);
+    return count;
+}
+
+size_t bitmap_to_list_scalar(const uint64_t* words, size_t first_word, size_t last_word, int* out) {
+    size_t count = 0;
+    for (size_t w = first_word; w < last_word; ++w) {
+        uint64_t bits = words[w];
+        while (bits) {
+            out[count++] = static_cast<int>(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+    return count;
+}
+
+#ifdef BFS_SIMD_X86
+
+// AVX2: 8-wide gathers of the 32-bit bitmap words holding each id
+
+__attribute__((target("avx2")))
+size_t first_in_bitmap_avx2(const int* ids, size_t n, const uint64_t* bitmap) {
+    const int* words = reinterpret_cast<const int*>(bitmap);
+    const __m256i low5 = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        const __m256i word = _mm256_i32gather_epi32(words, _mm256_srli_epi32(v, 5), 4);
+        const __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(v, low5)), one);
+        const int hits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bit, one)));
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    const size_t rest = first_in_bitmap_scalar(ids + i, n - i, bitmap);
+    return i + rest;
+}
+
+// Hit mask of eight 16-bit IDs
+__attribute__((target("avx2")))
+inline int hits8_avx2(__m128i packed, const uint64_t* bitmap) {
+    const __m256i v = _mm256_cvtepu16_epi32(packed);
+    const __m256i word = _mm256_i32gather_epi32(reinterpret_cast<const int*>(bitmap), _mm256_srli_epi32(v, 5), 4);
+    const __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(v, _mm256_set1_epi32(31))),
+                                         _mm256_set1_epi32(1));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bit, _mm256_set1_epi32(1))));
+}
+
+// 16-bit IDs: one load feeds two 8-wide gathers
+__attribute__((target("avx2")))
+size_t first_in_bitmap_16_avx2(const uint16_t* ids, size_t n, const uint64_t* bitmap) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        const int hits = hits8_avx2(_mm256_castsi256_si128(v), bitmap) |
+                         (hits8_avx2(_mm256_extracti128_si256(v, 1), bitmap) << 8);
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    const size_t rest = first_in_bitmap_scalar(ids + i, n - i, bitmap);
+    return i + rest;
+}
+
+// Nibble-table popcount (vpshufb) summed per 64-bit lane with vpsadbw
+__attribute__((target("avx2,popcnt")))
+size_t popcount_avx2(const uint64_t* words, size_t first_word, size_t last_word) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    size_t w = first_word;
+    for (; w + 4 <= last_word; w += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + w));
+        const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, low4));
+        const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low4));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    size_t count = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                   _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    for (; w < last_word; ++w) count += _mm_popcnt_u64(words[w]);
+    return count;
+}
+
+// BMI2 turns each byte of the bitmap into packed bit positions: PDEP spreads
+// the byte to one byte per bit, PEXT keeps the matching entries of 0..7.
+__attribute__((target("avx2,bmi2,popcnt")))
+size_t bitmap_to_list_avx2(const uint64_t* words, size_t first_word, size_t last_word, int* out) {
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    size_t count = 0;
+
+    for (size_t w = first_word; w < last_word; ++w) {
+        const uint64_t bits = words[w];
+        if (!bits) continue;
+        for (int byte = 0; byte < 8; ++byte) {
+            const uint64_t mask = (bits >> (8 * byte)) & 0xff;
+            if (!mask) continue;
+
+            const uint64_t spread = _pdep_u64(mask, 0x0101010101010101ULL) * 0xff;
+            const uint64_t packed = _pext_u64(0x0706050403020100ULL, spread);
+            const __m256i index = _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(packed))),
+                                                   _mm256_set1_epi32(static_cast<int>(w * 64 + 8 * byte)));
+            const int k = _mm_popcnt_u64(mask);
+            _mm256_maskstore_epi32(out + count, _mm256_cmpgt_epi32(_mm256_set1_epi32(k), lanes), index);
+            count += k;
+        }
+    }
+    return count;
+}
+
+// AVX-512: 16-wide gathers and compress-stores
+
+__attribute__((target("avx512f")))
+size_t first_in_bitmap_avx512(const int* ids, size_t n, const uint64_t* bitmap) {
+    const __m512i low5 = _mm512_set1_epi32(31);
+    const __m512i one = _mm512_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i v = _mm512_loadu_si512(ids + i);
+        const __m512i word = _mm512_i32gather_epi32(_mm512_srli_epi32(v, 5), bitmap, 4);
+        const __mmask16 hits = _mm512_test_epi32_mask(_mm512_srlv_epi32(word, _mm512_and_si512(v, low5)), one);
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    const size_t rest = first_in_bitmap_scalar(ids + i, n - i, bitmap);
+    return i + rest;
+}
+
+// Hit mask of sixteen 16-bit IDs
+__attribute__((target("avx512f")))
+inline uint32_t hits16_avx512(__m256i packed, const uint64_t* bitmap) {
+    const __m512i v = _mm512_cvtepu16_epi32(packed);
+    const __m512i word = _mm512_i32gather_epi32(_mm512_srli_epi32(v, 5), bitmap, 4);
+    return _mm512_test_epi32_mask(_mm512_srlv_epi32(word, _mm512_and_si512(v, _mm512_set1_epi32(31))),
+                                  _mm512_set1_epi32(1));
+}
+
+// 16-bit IDs: one load feeds two 16-wide gathers
+__attribute__((target("avx512f")))
+size_t first_in_bitmap_16_avx512(const uint16_t* ids, size_t n, const uint64_t* bitmap) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m512i v = _mm512_loadu_si512(ids + i);
+        const uint32_t hits = hits16_avx512(_mm512_castsi512_si256(v), bitmap) |
+                              (hits16_avx512(_mm512_extracti64x4_epi64(v, 1), bitmap) << 16);
+        if (hits) return i + __builtin_ctz(hits);
+    }
+    const size_t rest = first_in_bitmap_scalar(ids + i, n - i, bitmap);
+    return i + rest;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+size_t popcount_avx512(const uint64_t* words, size_t first_word, size_t last_word) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t w = first_word;
+    for (; w + 8 <= last_word; w += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + w)));
+    }
+    size_t count = _mm512_reduce_add_epi64(acc);
+    for (; w < last_word; ++w) count += _mm_popcnt_u64(words[w]);
+    return count;
+}
+
+__attribute__((target("avx512f,popcnt")))
+size_t bitmap_to_list_avx512(const uint64_t* words, size_t first_word, size_t last_word, int* out) {
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    size_t count = 0;
+
+    for (size_t w = first_word; w < last_word; ++w) {
+        const uint64_t bits = words[w];
+        if (!bits) continue;
+        for (int part = 0; part < 4; ++part) {
+            const __mmask16 mask = static_cast<__mmask16>(bits >> (16 * part));
+            if (!mask) continue;
+            const __m512i index = _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(w * 64 + 16 * part)));
+            _mm512_mask_compressstoreu_epi32(out + count, mask, index);
+            count += _mm_popcnt_u32(mask);
+        }
+    }
+    return count;
+}
+
+#endif // BFS_SIMD_X86
+
+struct Dispatch {
+    const char* isa = "scalar";
+    size_t (*first_in_bitmap)(const int*, size_t, const uint64_t*) = first_in_bitmap_scalar<int>;
+    size_t (*first_in_bitmap_16)(const uint16_t*, size_t, const uint64_t*) = first_in_bitmap_scalar<uint16_t>;
+    size_t (*popcount)(const uint64_t*, size_t, size_t) = popcount_scalar;
+    size_t (*bitmap_to_list)(const uint64_t*, size_t, size_t, int*) = bitmap_to_list_scalar;
+};
+
+Dispatch resolve() {
+    Dispatch d;
+#ifdef BFS_SIMD_X86
+    std::string cap = "avx512";
+    if (const char* env = std::getenv("BFS_SIMD")) cap = env;
+
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+                      __builtin_cpu_supports("popcnt");
+    const bool avx512 = avx2 && __builtin_cpu_supports("avx512f");
+
+    if (avx512 && cap == "avx512") {
+        d.isa = "avx512";
+        d.first_in_bitmap = first_in_bitmap_avx512;
+        d.first_in_bitmap_16 = first_in_bitmap_16_avx512;
+        d.bitmap_to_list = bitmap_to_list_avx512;
+        // VPOPCNTQ is a later extension than AVX-512F
+        d.popcount = __builtin_cpu_supports("avx512vpopcntdq") ? popcount_avx512 : popcount_avx2;
+    } else if (avx2 && (cap == "avx512" || cap == "avx2")) {
+        d.isa = "avx2";
+        d.first_in_bitmap = first_in_bitmap_avx2;
+        d.first_in_bitmap_16 = first_in_bitmap_16_avx2;
+        d.popcount = popcount_avx2;
+        d.bitmap_to_list = bitmap_to_list_avx2;
+    }
+#endif
+    return d;
+}
+
+const Dispatch& kernels() {
+    static const Dispatch d = resolve();
+    return d;
+}
+
+} // namespace
+
+const char* isa() {
+    return kernels().isa;
+}
+
+size_t first_in_bitmap(const int* ids, size_t n, const uint64_t* bitmap) {
+    return kernels().first_in_bitmap(ids, n, bitmap);
+}
+
+size_t first_in_bitmap(const uint16_t* ids, size_t n, const uint64_t* bitmap) {
+    return kernels().first_in_bitmap_16(ids, n, bitmap);
+}
+
+size_t popcount(const uint64_t* words, size_t first_word, size_t last_word) {
+    return kernels().popcount(words, first_word, last_word);
+}
+
+size_t bitmap_to_list(const uint64_t* words, size_t first_word, size_t last_word, int* out) {
+    return kernels().bitmap_to_list(words, first_word, last_word, out);
+}
+
+} // namespace Kernels
@@ -0,0 +1,201 @@
+#include "sssp.h"
+#include "frontier.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ParallelBFS {
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Lowers dist to candidate if it is smaller; true when this call improved it.
+template <typename T>
+bool relax(std::atomic<T>& dist, T candidate) {
+    T current = dist.load(std::memory_order_relaxed);
+    while (candidate < current) {
+        if (dist.compare_exchange_weak(current, candidate)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool has_unit_weights(const Graph& g) {
+    if (!g.weighted()) return true;
+
+    const size_t non_unit = Parallel::sum<size_t>(g.weights.size(), [&](size_t e) {
+        return g.weights[e] != 1.0f ? 1 : 0;
+    });
+    return non_unit == 0;
+}
+
+void delta_stepping(const Graph& g, int source, std::vector<std::atomic<float>>& dist, float delta) {
+    const size_t V = g.vertex_count();
+
+    if (has_unit_weights(g)) {
+        std::vector<std::atomic<int>> hops(V);
+        optimized(g, source, hops);
+
+        Parallel::parallel_for(V, [&](size_t i) {
+            int h = hops[i].load(std::memory_order_relaxed);
+            dist[i].store(h == INT_MAX ? INF : static_cast<float>(h), std::memory_order_relaxed);
+        });
+        return;
+    }
+
+    const double weight_sum = Parallel::sum<double>(g.weights.size(), [&](size_t e) {
+        return static_cast<double>(g.weights[e]);
+    });
+    // NaN passes a plain w < 0 test and would index buckets with garbage
+    const size_t rejected = Parallel::sum<size_t>(g.weights.size(), [&](size_t e) {
+        const float w = g.weights[e];
+        return !(w >= 0) || !std::isfinite(w) ? 1 : 0;
+    });
+    if (rejected > 0) throw std::invalid_argument("delta_stepping requires finite non-negative edge weights");
+    if (delta <= 0) {
+        delta = static_cast<float>(weight_sum / std::max<size_t>(1, g.weights.size()));
+        if (delta <= 0) delta = 1.0f;
+    }
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        dist[i].store(INF, std::memory_order_relaxed);
+    });
+    dist[source].store(0.0f);
+
+    // Buckets hold candidate vertices by floor(dist / delta); entries whose
+    // distance has since moved to a lower bucket are dropped when popped.
+    std::vector<std::vector<int>> buckets(1, std::vector<int>{source});
+    auto bucket_of = [&](int v) {
+        return static_cast<size_t>(dist[v].load(std::memory_order_relaxed) / delta);
+    };
+    auto distribute = [&](const std::vector<int>& improved) {
+        for (int v : improved) {
+            size_t b = bucket_of(v);
+            if (b >= buckets.size()) buckets.resize(b + 1);
+            buckets[b].push_back(v);
+        }
+    };
+
+    Workspace::Lease workspace(Parallel::max_threads());
+
+    // Relaxes the light (w <= delta) or heavy edges out of every frontier vertex
+    auto relax_edges = [&](const std::vector<int>& frontier, std::vector<int>& improved, bool light) {
+        Frontier::expand(*workspace, frontier, improved, [&](int u, std::vector<int>& out) {
+            const float du = dist[u].load(std::memory_order_relaxed);
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const float w = g.weights[e];
+                if ((w <= delta) != light) continue;
+                const int v = g.edges[e];
+                if (relax(dist[v], du + w)) out.push_back(v);
+            }
+        });
+    };
+
+    std::vector<int>& current_frontier = workspace->frontier(0);
+    std::vector<int>& improved = workspace->frontier(1);
+    std::vector<int> settled;
+
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        settled.clear();
+
+        while (!buckets[i].empty()) {
+            current_frontier.clear();
+            std::swap(current_frontier, buckets[i]);
+            std::sort(current_frontier.begin(), current_frontier.end());
+            current_frontier.erase(std::unique(current_frontier.begin(), current_frontier.end()), current_frontier.end());
+            current_frontier.erase(std::remove_if(current_frontier.begin(), current_frontier.end(),
+                                                  [&](int v) { return bucket_of(v) != i; }),
+                                   current_frontier.end());
+
+            settled.insert(settled.end(), current_frontier.begin(), current_frontier.end());
+            relax_edges(current_frontier, improved, true);
+            distribute(improved);
+        }
+
+        // Vertices in bucket i are final now; their heavy edges only reach later buckets
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        relax_edges(settled, improved, false);
+        distribute(improved);
+    }
+}
+
+std::vector<uint8_t> small_integer_weights(const Graph& g) {
+    std::vector<uint8_t> compact(g.edge_count(), 1);
+    if (!g.weighted()) return compact;
+
+    const size_t rejected = Parallel::sum<size_t>(g.weights.size(), [&](size_t e) -> size_t {
+        const float w = g.weights[e];
+        if (w >= 0 && w <= 255 && w == std::floor(w)) {
+            compact[e] = static_cast<uint8_t>(w);
+            return 0;
+        }
+        return 1;
+    });
+    if (rejected > 0) {
+        throw std::invalid_argument("dial_bfs requires integer edge weights in [0, 255]");
+    }
+    return compact;
+}
+
+void dial_bfs(const Graph& g, const std::vector<uint8_t>& weights, int source, std::vector<std::atomic<int>>& dist) {
+    const size_t V = g.vertex_count();
+    if (weights.size() != g.edge_count()) {
+        throw std::invalid_argument("Edge weights must align with edges");
+    }
+
+    const uint8_t max_weight = Parallel::reduce(weights.size(), uint8_t(0),
+        [&](size_t e) { return weights[e]; },
+        [](uint8_t a, uint8_t b) { return std::max(a, b); });
+
+    Parallel::parallel_for(V, [&](size_t i) {
+        dist[i].store(INT_MAX, std::memory_order_relaxed);
+    });
+    dist[source].store(0);
+
+    // Pending distances always lie in [level, level + max_weight], so bucket
+    // level % (max_weight + 1) holds exactly the vertices at the current level.
+    const size_t bucket_count = static_cast<size_t>(max_weight) + 1;
+    std::vector<std::vector<int>> buckets(bucket_count);
+    buckets[0].push_back(source);
+    size_t pending = 1;
+
+    Workspace::Lease workspace(Parallel::max_threads());
+    std::vector<int>& current_frontier = workspace->frontier(0);
+    std::vector<int>& improved = workspace->frontier(1);
+
+    for (int level = 0; pending > 0; ++level) {
+        std::vector<int>& bucket = buckets[level % bucket_count];
+
+        while (!bucket.empty()) {
+            pending -= bucket.size();
+            current_frontier.clear();
+            std::swap(current_frontier, bucket);
+            std::sort(current_frontier.begin(), current_frontier.end());
+            current_frontier.erase(std::unique(current_frontier.begin(), current_frontier.end()), current_frontier.end());
+            current_frontier.erase(std::remove_if(current_frontier.begin(), current_frontier.end(),
+                                                  [&](int v) { return dist[v].load(std::memory_order_relaxed) != level; }),
+                                   current_frontier.end());
+
+            Frontier::expand(*workspace, current_frontier, improved, [&](int u, std::vector<int>& out) {
+                for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    const int v = g.edges[e];
+                    if (relax(dist[v], level + weights[e])) out.push_back(v);
+                }
+            });
+
+            // Zero-weight edges refill the current bucket and are drained before moving on
+            for (int v : improved) {
+                buckets[dist[v].load(std::memory_order_relaxed) % bucket_count].push_back(v);
+            }
+            pending += improved.size();
+        }
+    }
+}
+
+} // namespace ParallelBFS
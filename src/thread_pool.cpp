@@ -0,0 +1,157 @@
+#include "thread_pool.h"
+#include "topology.h"
+#include <algorithm>
+
+namespace {
+
+// Rounds a worker spins (yielding) before sleeping on the condition variable
+constexpr int SPIN_ROUNDS = 4096;
+
+// Holds the calling thread on worker 0's CPU for one run() and gives it its
+// own affinity back afterwards, so the pool never narrows the caller for good
+class CallerPin {
+public:
+    explicit CallerPin(const std::vector<int>& cpus) {
+        if (cpus.empty()) return;
+        saved_ = Topology::current_affinity();
+        Topology::pin_current_thread(cpus[0]);
+    }
+    ~CallerPin() {
+        if (!saved_.empty()) Topology::set_current_affinity(saved_);
+    }
+
+    CallerPin(const CallerPin&) = delete;
+    CallerPin& operator=(const CallerPin&) = delete;
+
+private:
+    std::vector<int> saved_;
+};
+
+} // namespace
+
+bool ThreadPool::WorkQueue::pop_back(Range& out) {
+    while (lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+    bool found = !chunks.empty();
+    if (found) {
+        out = chunks.back();
+        chunks.pop_back();
+    }
+    lock.clear(std::memory_order_release);
+    return found;
+}
+
+bool ThreadPool::WorkQueue::steal_front(Range& out) {
+    while (lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+    bool found = !chunks.empty();
+    if (found) {
+        out = chunks.front();
+        chunks.pop_front();
+    }
+    lock.clear(std::memory_order_release);
+    return found;
+}
+
+void ThreadPool::WorkQueue::push_back(Range r) {
+    while (lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+    chunks.push_back(r);
+    lock.clear(std::memory_order_release);
+}
+
+ThreadPool::ThreadPool(size_t threads, const std::vector<int>& cpus)
+    : workers_(std::max<size_t>(1, threads)), cpus_(cpus), queues_(new WorkQueue[std::max<size_t>(1, threads)]) {
+    threads_.reserve(workers_ - 1);
+    for (size_t w = 1; w < workers_; ++w) {
+        threads_.emplace_back([this, w] { worker_loop(w); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void ThreadPool::pin(size_t worker) const {
+    if (!cpus_.empty()) Topology::pin_current_thread(cpus_[worker % cpus_.size()]);
+}
+
+void ThreadPool::worker_loop(size_t worker) {
+    pin(worker);
+    size_t seen = 0;
+    while (true) {
+        // Stay hot for back-to-back jobs, then fall asleep
+        for (int spin = 0; spin < SPIN_ROUNDS; ++spin) {
+            if (generation_.load(std::memory_order_acquire) != seen || stop_.load()) break;
+            std::this_thread::yield();
+        }
+        if (generation_.load(std::memory_order_acquire) == seen && !stop_.load()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return generation_.load() != seen || stop_.load(); });
+        }
+        if (stop_.load()) return;
+
+        seen = generation_.load(std::memory_order_acquire);
+        (*job_)(worker);
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ThreadPool::run(const std::function<void(size_t worker)>& fn) {
+    CallerPin caller(cpus_);
+    if (workers_ == 1) {
+        fn(0);
+        return;
+    }
+
+    job_ = &fn;
+    pending_.store(workers_ - 1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_all();
+
+    fn(0);
+    while (pending_.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+}
+
+void ThreadPool::barrier() {
+    if (workers_ == 1) return;
+
+    const size_t sense = barrier_sense_.load(std::memory_order_acquire);
+    if (barrier_count_.fetch_add(1, std::memory_order_acq_rel) + 1 == workers_) {
+        barrier_count_.store(0, std::memory_order_relaxed);
+        barrier_sense_.store(sense + 1, std::memory_order_release);
+    } else {
+        while (barrier_sense_.load(std::memory_order_acquire) == sense) std::this_thread::yield();
+    }
+}
+
+void ThreadPool::for_each(size_t worker, size_t n, size_t grain,
+                          const std::function<void(size_t begin, size_t end, size_t worker)>& fn) {
+    grain = std::max<size_t>(1, grain);
+    const size_t begin = n * worker / workers_;
+    const size_t end = n * (worker + 1) / workers_;
+    for (size_t b = begin; b < end; b += grain) {
+        queues_[worker].push_back({b, std::min(b + grain, end)});
+    }
+    // Every deque is seeded before anyone starts stealing
+    barrier();
+
+    Range r;
+    while (queues_[worker].pop_back(r)) fn(r.begin, r.end, worker);
+    for (size_t k = 1; k < workers_; ++k) {
+        WorkQueue& victim = queues_[(worker + k) % workers_];
+        while (victim.steal_front(r)) fn(r.begin, r.end, worker);
+    }
+
+    barrier();
+}
+
+void ThreadPool::parallel_for(size_t n, size_t grain,
+                              const std::function<void(size_t begin, size_t end, size_t worker)>& fn) {
+    run([&](size_t worker) { for_each(worker, n, grain, fn); });
+}
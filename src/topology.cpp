@@ -0,0 +1,253 @@
+#include "topology.h"
+#include "parallel_backend.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Topology {
+
+namespace {
+
+bool read_line(const std::string& path, std::string& out) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, out));
+}
+
+int read_int(const std::string& path, int fallback) {
+    std::string line;
+    if (!read_line(path, line)) return fallback;
+    try {
+        return std::stoi(line);
+    } catch (...) {
+        return fallback;
+    }
+}
+
+// Parses sysfs CPU lists such as "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (part.empty()) continue;
+        size_t dash = part.find('-');
+        try {
+            int first = std::stoi(part.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(part.substr(dash + 1));
+            for (int c = first; c <= last; ++c) cpus.push_back(c);
+        } catch (...) {
+            continue;
+        }
+    }
+    return cpus;
+}
+
+CpuTopology flat_topology() {
+    CpuTopology topology;
+    const int n = std::max(1u, std::thread::hardware_concurrency());
+    for (int c = 0; c < n; ++c) topology.cpus.push_back({c, c, 0, 0});
+    topology.cores = n;
+    topology.packages = 1;
+    topology.nodes = 1;
+    return topology;
+}
+
+CpuTopology read_topology() {
+#ifdef __linux__
+    std::string online;
+    if (!read_line("/sys/devices/system/cpu/online", online)) return flat_topology();
+    std::vector<int> ids = parse_cpu_list(online);
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        ids.erase(std::remove_if(ids.begin(), ids.end(), [&](int c) { return !CPU_ISSET(c, &allowed); }), ids.end());
+    }
+    if (ids.empty()) return flat_topology();
+
+    std::map<int, int> node_of;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.rfind("node", 0) != 0 || name.size() == 4) continue;
+            int node;
+            try {
+                node = std::stoi(name.substr(4));
+            } catch (...) {
+                continue;
+            }
+            std::string list;
+            if (!read_line("/sys/devices/system/node/" + name + "/cpulist", list)) continue;
+            for (int c : parse_cpu_list(list)) node_of[c] = node;
+        }
+        closedir(dir);
+    }
+
+    CpuTopology topology;
+    std::map<std::pair<int, int>, int> core_index;  // (package, core_id) -> dense core
+    std::map<int, int> package_index;
+    std::map<int, int> node_index;
+
+    for (int c : ids) {
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(c) + "/topology/";
+        const int package = read_int(base + "physical_package_id", 0);
+        const int core_id = read_int(base + "core_id", c);
+        const int node = node_of.count(c) ? node_of[c] : 0;
+
+        auto core = core_index.emplace(std::make_pair(package, core_id), static_cast<int>(core_index.size())).first->second;
+        auto pkg = package_index.emplace(package, static_cast<int>(package_index.size())).first->second;
+        auto nd = node_index.emplace(node, static_cast<int>(node_index.size())).first->second;
+        topology.cpus.push_back({c, core, pkg, nd});
+    }
+
+    topology.cores = core_index.size();
+    topology.packages = package_index.size();
+    topology.nodes = node_index.size();
+    return topology;
+#else
+    return flat_topology();
+#endif
+}
+
+} // namespace
+
+const CpuTopology& detect() {
+    static const CpuTopology topology = read_topology();
+    return topology;
+}
+
+std::vector<int> placement(const CpuTopology& topology, PinPolicy policy, size_t threads) {
+    if (policy == PinPolicy::None || topology.cpus.empty() || threads == 0) return {};
+
+    std::vector<Cpu> compact = topology.cpus;
+    std::sort(compact.begin(), compact.end(), [](const Cpu& a, const Cpu& b) {
+        return std::tie(a.node, a.package, a.core, a.id) < std::tie(b.node, b.package, b.core, b.id);
+    });
+
+    std::vector<int> order;
+    if (policy == PinPolicy::Compact) {
+        for (const Cpu& c : compact) order.push_back(c.id);
+    } else if (policy == PinPolicy::OnePerCore) {
+        int last_core = -1;
+        for (const Cpu& c : compact) {
+            if (c.core != last_core) order.push_back(c.id);
+            last_core = c.core;
+        }
+    } else {
+        // nodes[n][i] = SMT siblings of the i-th core on node n
+        std::vector<std::vector<std::vector<int>>> nodes(topology.nodes);
+        int last_core = -1;
+        for (const Cpu& c : compact) {
+            if (c.core != last_core) nodes[c.node].emplace_back();
+            nodes[c.node].back().push_back(c.id);
+            last_core = c.core;
+        }
+
+        size_t max_cores = 0, max_smt = 0;
+        for (const auto& node : nodes) {
+            max_cores = std::max(max_cores, node.size());
+            for (const auto& core : node) max_smt = std::max(max_smt, core.size());
+        }
+        for (size_t k = 0; k < max_smt; ++k) {
+            for (size_t i = 0; i < max_cores; ++i) {
+                for (const auto& node : nodes) {
+                    if (i < node.size() && k < node[i].size()) order.push_back(node[i][k]);
+                }
+            }
+        }
+    }
+
+    std::vector<int> cpus(threads);
+    for (size_t t = 0; t < threads; ++t) cpus[t] = order[t % order.size()];
+    return cpus;
+}
+
+bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+std::vector<int> current_affinity() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool set_current_affinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+std::vector<int> pin_worker_threads(PinPolicy policy) {
+    std::vector<int> cpus = placement(detect(), policy, Parallel::max_threads());
+    if (cpus.empty()) return cpus;
+
+    // Thread 0 is the caller: pinning it would outlive the parallel work
+    Parallel::region([&](size_t thread, size_t) {
+        if (thread != 0) pin_current_thread(cpus[thread % cpus.size()]);
+    });
+    return cpus;
+}
+
+PinPolicy parse_policy(const std::string& name) {
+    if (name == "none") return PinPolicy::None;
+    if (name == "compact") return PinPolicy::Compact;
+    if (name == "scatter") return PinPolicy::Scatter;
+    if (name == "core" || name == "one-per-core") return PinPolicy::OnePerCore;
+    throw std::invalid_argument("Unknown pin policy: " + name + " (none, compact, scatter, core)");
+}
+
+const char* policy_name(PinPolicy policy) {
+    switch (policy) {
+        case PinPolicy::Compact: return "compact";
+        case PinPolicy::Scatter: return "scatter";
+        case PinPolicy::OnePerCore: return "core";
+        default: return "none";
+    }
+}
+
+std::string describe(const CpuTopology& topology) {
+    std::ostringstream out;
+    out << topology.cpus.size() << " CPUs, " << topology.cores << " cores, "
+        << topology.packages << " packages, " << topology.nodes << " NUMA nodes";
+    return out.str();
+}
+
+} // namespace Topology
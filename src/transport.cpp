@@ -0,0 +1,419 @@
+#include "transport.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BFS_HAVE_FORK 1
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Distributed {
+
+void Transport::count_sent(const std::vector<Buffer>& out) {
+    for (int r = 0; r < size_; ++r) {
+        if (r != rank_) bytes_sent_ += out[r].size();
+    }
+}
+
+std::vector<std::vector<int>> Transport::exchange_ints(const std::vector<std::vector<int>>& out) {
+    std::vector<Buffer> bytes(size_);
+    for (int r = 0; r < size_; ++r) {
+        bytes[r].resize(out[r].size() * sizeof(int));
+        if (!out[r].empty()) std::memcpy(bytes[r].data(), out[r].data(), bytes[r].size());
+    }
+
+    std::vector<Buffer> in = exchange(std::move(bytes));
+    std::vector<std::vector<int>> result(size_);
+    for (int r = 0; r < size_; ++r) {
+        result[r].resize(in[r].size() / sizeof(int));
+        if (!result[r].empty()) std::memcpy(result[r].data(), in[r].data(), result[r].size() * sizeof(int));
+    }
+    return result;
+}
+
+std::vector<long long> Transport::all_gather(long long value) {
+    Buffer mine(sizeof(value));
+    std::memcpy(mine.data(), &value, sizeof(value));
+
+    std::vector<Buffer> in = exchange(std::vector<Buffer>(size_, mine));
+    std::vector<long long> values(size_);
+    for (int r = 0; r < size_; ++r) {
+        if (in[r].size() != sizeof(value)) throw std::runtime_error("Malformed reduction message");
+        std::memcpy(&values[r], in[r].data(), sizeof(value));
+    }
+    return values;
+}
+
+long long Transport::all_reduce_sum(long long value) {
+    std::vector<long long> values = all_gather(value);
+    return std::accumulate(values.begin(), values.end(), 0LL);
+}
+
+long long Transport::all_reduce_max(long long value) {
+    std::vector<long long> values = all_gather(value);
+    return *std::max_element(values.begin(), values.end());
+}
+
+void Transport::barrier() {
+    exchange(std::vector<Buffer>(size_));
+}
+
+TransportKind parse_transport(const std::string& name) {
+    if (name == "shm") return TransportKind::SharedMemory;
+    if (name == "socket") return TransportKind::Socket;
+    throw std::invalid_argument("Unknown transport: " + name + " (shm, socket)");
+}
+
+const char* transport_name(TransportKind kind) {
+    return kind == TransportKind::SharedMemory ? "shm" : "socket";
+}
+
+#ifdef BFS_HAVE_FORK
+
+namespace {
+
+// Bytes per (sender, receiver) mailbox; larger messages go in several rounds
+constexpr size_t SLOT_BYTES = size_t(256) << 10;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Process-shared barrier needs lock-free atomics");
+
+// Placed at the start of the shared mapping, before fork()
+struct alignas(64) SharedHeader {
+    std::atomic<uint32_t> arrived{0};
+    std::atomic<uint32_t> generation{0};
+};
+
+struct SlotHeader {
+    uint64_t bytes;      // Payload in this round
+    uint64_t remaining;  // Payload still to come in later rounds
+};
+
+constexpr size_t SLOT_STRIDE = (sizeof(SlotHeader) + SLOT_BYTES + 63) / 64 * 64;
+
+size_t shared_bytes(int ranks) {
+    return sizeof(SharedHeader) + static_cast<size_t>(ranks) * ranks * SLOT_STRIDE;
+}
+
+// Mailboxes in one MAP_SHARED mapping inherited by every rank. A round
+// writes one chunk per destination, meets at the barrier, reads the chunks
+// addressed to this rank and meets again; rounds repeat while any mailbox
+// still has data pending.
+class SharedMemoryTransport : public Transport {
+public:
+    SharedMemoryTransport(int rank, int size, uint8_t* base)
+        : Transport(rank, size), header_(reinterpret_cast<SharedHeader*>(base)), slots_(base + sizeof(SharedHeader)) {}
+
+    std::vector<Buffer> exchange(std::vector<Buffer> out) override {
+        const int P = size();
+        const int me = rank();
+        if (static_cast<int>(out.size()) != P) throw std::invalid_argument("exchange needs one buffer per rank");
+        count_sent(out);
+
+        std::vector<Buffer> in(P);
+        in[me] = std::move(out[me]);
+        std::vector<size_t> sent(P, 0);
+
+        while (true) {
+            for (int r = 0; r < P; ++r) {
+                if (r == me) continue;
+                SlotHeader* slot = header(me, r);
+                const size_t chunk = std::min(SLOT_BYTES, out[r].size() - sent[r]);
+                if (chunk > 0) std::memcpy(data(me, r), out[r].data() + sent[r], chunk);
+                sent[r] += chunk;
+                slot->bytes = chunk;
+                slot->remaining = out[r].size() - sent[r];
+            }
+            sync();
+
+            bool pending = false;
+            for (int r = 0; r < P; ++r) {
+                if (r == me) continue;
+                const SlotHeader* slot = header(r, me);
+                in[r].insert(in[r].end(), data(r, me), data(r, me) + slot->bytes);
+            }
+            for (int s = 0; s < P && !pending; ++s) {
+                for (int r = 0; r < P; ++r) {
+                    if (s != r && header(s, r)->remaining > 0) {
+                        pending = true;
+                        break;
+                    }
+                }
+            }
+            sync();
+            if (!pending) break;
+        }
+        return in;
+    }
+
+private:
+    SlotHeader* header(int from, int to) const {
+        return reinterpret_cast<SlotHeader*>(slots_ + (static_cast<size_t>(from) * size() + to) * SLOT_STRIDE);
+    }
+    uint8_t* data(int from, int to) const {
+        return reinterpret_cast<uint8_t*>(header(from, to)) + sizeof(SlotHeader);
+    }
+
+    // Same generation barrier as ThreadPool::barrier, across processes
+    void sync() {
+        const uint32_t generation = header_->generation.load(std::memory_order_acquire);
+        if (header_->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == static_cast<uint32_t>(size())) {
+            header_->arrived.store(0, std::memory_order_relaxed);
+            header_->generation.store(generation + 1, std::memory_order_release);
+        } else {
+            while (header_->generation.load(std::memory_order_acquire) == generation) std::this_thread::yield();
+        }
+    }
+
+    SharedHeader* header_;
+    uint8_t* slots_;
+};
+
+// One connected Unix-domain stream socket per peer. Messages are framed
+// with an 8-byte length; all peers are serviced from one poll() loop so
+// no pair of ranks can block each other on full socket buffers.
+class SocketTransport : public Transport {
+public:
+    SocketTransport(int rank, int size, std::vector<int> peers) : Transport(rank, size), peers_(std::move(peers)) {
+        for (int fd : peers_) {
+            if (fd >= 0) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        }
+    }
+
+    ~SocketTransport() override {
+        for (int fd : peers_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    std::vector<Buffer> exchange(std::vector<Buffer> out) override {
+        const int P = size();
+        const int me = rank();
+        if (static_cast<int>(out.size()) != P) throw std::invalid_argument("exchange needs one buffer per rank");
+        count_sent(out);
+
+        struct Peer {
+            Buffer outgoing;         // Length prefix + payload
+            size_t written = 0;
+            uint8_t prefix[8];
+            size_t prefix_read = 0;
+            uint64_t expected = 0;
+            size_t payload_read = 0;
+        };
+
+        std::vector<Buffer> in(P);
+        in[me] = std::move(out[me]);
+        std::vector<Peer> state(P);
+        for (int r = 0; r < P; ++r) {
+            if (r == me) continue;
+            const uint64_t length = out[r].size();
+            state[r].outgoing.resize(sizeof(length) + length);
+            std::memcpy(state[r].outgoing.data(), &length, sizeof(length));
+            if (length > 0) std::memcpy(state[r].outgoing.data() + sizeof(length), out[r].data(), length);
+            Buffer().swap(out[r]);
+        }
+
+        auto sending = [&](int r) { return state[r].written < state[r].outgoing.size(); };
+        auto receiving = [&](int r) {
+            return state[r].prefix_read < sizeof(state[r].prefix) || state[r].payload_read < state[r].expected;
+        };
+
+        std::vector<pollfd> fds;
+        std::vector<int> ranks;
+        while (true) {
+            fds.clear();
+            ranks.clear();
+            for (int r = 0; r < P; ++r) {
+                if (r == me) continue;
+                short events = (sending(r) ? POLLOUT : 0) | (receiving(r) ? POLLIN : 0);
+                if (events) {
+                    fds.push_back({peers_[r], events, 0});
+                    ranks.push_back(r);
+                }
+            }
+            if (fds.empty()) break;
+
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+            }
+
+            for (size_t i = 0; i < fds.size(); ++i) {
+                const int r = ranks[i];
+                Peer& p = state[r];
+                if ((fds[i].revents & POLLOUT) && sending(r)) {
+                    const ssize_t n = ::send(fds[i].fd, p.outgoing.data() + p.written, p.outgoing.size() - p.written, SEND_FLAGS);
+                    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                        throw std::runtime_error("Send to rank " + std::to_string(r) + " failed: " + std::strerror(errno));
+                    }
+                    if (n > 0) p.written += n;
+                }
+                if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && receiving(r)) {
+                    ssize_t n;
+                    if (p.prefix_read < sizeof(p.prefix)) {
+                        n = ::read(fds[i].fd, p.prefix + p.prefix_read, sizeof(p.prefix) - p.prefix_read);
+                        if (n > 0) {
+                            p.prefix_read += n;
+                            if (p.prefix_read == sizeof(p.prefix)) {
+                                std::memcpy(&p.expected, p.prefix, sizeof(p.expected));
+                                in[r].resize(p.expected);
+                            }
+                        }
+                    } else {
+                        n = ::read(fds[i].fd, in[r].data() + p.payload_read, p.expected - p.payload_read);
+                        if (n > 0) p.payload_read += n;
+                    }
+                    if (n == 0) throw std::runtime_error("Rank " + std::to_string(r) + " disconnected");
+                    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                        throw std::runtime_error("Receive from rank " + std::to_string(r) + " failed: " + std::strerror(errno));
+                    }
+                }
+            }
+        }
+        return in;
+    }
+
+private:
+#ifdef MSG_NOSIGNAL
+    static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    static constexpr int SEND_FLAGS = 0;
+#endif
+
+    std::vector<int> peers_;  // peers_[r] = socket to rank r, -1 for self
+};
+
+} // namespace
+
+int launch(int ranks, TransportKind kind, const std::function<int(Transport&)>& body) {
+    if (ranks < 1) throw std::invalid_argument("Rank count must be positive");
+
+    // Connections are set up before fork() so every rank inherits its end
+    uint8_t* shared = nullptr;
+    const size_t bytes = shared_bytes(ranks);
+    std::vector<std::vector<int>> sockets(ranks, std::vector<int>(ranks, -1));
+
+    if (kind == TransportKind::SharedMemory) {
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) throw std::runtime_error(std::string("mmap failed: ") + std::strerror(errno));
+        shared = static_cast<uint8_t*>(mapping);
+        new (shared) SharedHeader();
+    } else {
+        for (int i = 0; i < ranks; ++i) {
+            for (int j = i + 1; j < ranks; ++j) {
+                int pair[2];
+                if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+                    for (auto& row : sockets) for (int fd : row) if (fd >= 0) close(fd);
+                    throw std::runtime_error(std::string("socketpair failed: ") + std::strerror(errno));
+                }
+                sockets[i][j] = pair[0];
+                sockets[j][i] = pair[1];
+            }
+        }
+    }
+
+    // Anything still buffered would otherwise be printed once per rank
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    std::set<pid_t> running;
+    int status = 0;
+    for (int r = 0; r < ranks && status == 0; ++r) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            status = 1;
+            break;
+        }
+        if (pid == 0) {
+            int code = 1;
+            try {
+                if (kind == TransportKind::SharedMemory) {
+                    SharedMemoryTransport transport(r, ranks, shared);
+                    code = body(transport);
+                } else {
+                    for (int i = 0; i < ranks; ++i) {
+                        for (int j = 0; j < ranks; ++j) {
+                            if (i != r && sockets[i][j] >= 0) close(sockets[i][j]);
+                        }
+                    }
+                    SocketTransport transport(r, ranks, sockets[r]);
+                    code = body(transport);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Rank " << r << ": " << e.what() << "\n";
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            // Skip the parent's static destructors (thread pools, files)
+            _exit(code);
+        }
+        running.insert(pid);
+    }
+
+    for (auto& row : sockets) for (int fd : row) if (fd >= 0) close(fd);
+
+    // A failed rank leaves its peers waiting in a collective, so stop them too
+    if (status != 0) {
+        for (pid_t pid : running) kill(pid, SIGKILL);
+    }
+    while (!running.empty()) {
+        int child_status = 0;
+        const pid_t pid = waitpid(-1, &child_status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        running.erase(pid);
+        if (!WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0) {
+            if (status == 0) {
+                for (pid_t other : running) kill(other, SIGKILL);
+            }
+            status = 1;
+        }
+    }
+
+    if (shared) munmap(shared, bytes);
+    return status;
+}
+
+SharedBuffer::SharedBuffer(size_t bytes) : size_(bytes) {
+    if (bytes == 0) return;
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) throw std::runtime_error(std::string("mmap failed: ") + std::strerror(errno));
+    data_ = static_cast<uint8_t*>(mapping);
+}
+
+SharedBuffer::~SharedBuffer() {
+    if (data_) munmap(data_, size_);
+}
+
+#else
+
+int launch(int, TransportKind, const std::function<int(Transport&)>&) {
+    throw std::runtime_error("Multi-process launch needs a POSIX system");
+}
+
+SharedBuffer::SharedBuffer(size_t) {
+    throw std::runtime_error("Shared result buffers need a POSIX system");
+}
+
+SharedBuffer::~SharedBuffer() = default;
+
+#endif
+
+} // namespace Distributed
@@ -0,0 +1,78 @@
+#include "workspace.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+struct IdlePool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Workspace>> idle;
+};
+
+IdlePool& idle_pool() {
+    static IdlePool pool;
+    return pool;
+}
+
+} // namespace
+
+Workspace::Lease::Lease(size_t threads) : workspace_(nullptr) {
+    threads = std::max<size_t>(1, threads);
+    {
+        IdlePool& pool = idle_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        // Most recently returned first: its pages are the likeliest to still be cached
+        for (auto it = pool.idle.rbegin(); it != pool.idle.rend(); ++it) {
+            if ((*it)->threads() >= threads) {
+                workspace_ = it->release();
+                pool.idle.erase(std::next(it).base());
+                break;
+            }
+        }
+    }
+    if (workspace_ == nullptr) workspace_ = new Workspace(threads);
+}
+
+Workspace::Lease::~Lease() {
+    workspace_->reset();
+    IdlePool& pool = idle_pool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.idle.emplace_back(workspace_);
+}
+
+Workspace::Workspace(size_t threads)
+    : bags_{FrontierBag(threads), FrontierBag(threads)}, slots_(std::max<size_t>(1, threads)) {}
+
+void Workspace::drain_locals(std::vector<int>& out) {
+    size_t total = out.size();
+    for (const Slot& slot : slots_) total += slot.items.size();
+    out.reserve(total);
+    for (Slot& slot : slots_) {
+        out.insert(out.end(), slot.items.begin(), slot.items.end());
+        slot.items.clear();
+    }
+}
+
+void Workspace::reset() {
+    for (auto& frontier : frontiers_) frontier.clear();
+    for (auto& bag : bags_) {
+        // Publishes chunks left open by an interrupted level so clear() can recycle them
+        bag.seal();
+        bag.clear();
+    }
+    for (Slot& slot : slots_) {
+        slot.items.clear();
+        for (auto& bin : slot.bins) bin.clear();
+    }
+    for (auto& bin : bins_) bin.clear();
+}
+
+void Workspace::release_idle() {
+    std::vector<std::unique_ptr<Workspace>> doomed;
+    {
+        IdlePool& pool = idle_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        doomed.swap(pool.idle);
+    }
+}
@@ -0,0 +1,1152 @@
+#include "parallel_bfs.h"
+#include "apsp.h"
+#include "async_bfs.h"
+#include "binned_bfs.h"
+#include "bipartite.h"
+#include "distance_stats.h"
+#include "distributed_bfs.h"
+#include "frontier_bag.h"
+#include "graph_stats.h"
+#include "hybrid_bfs.h"
+#include "hyperanf.h"
+#include "kcore.h"
+#include "low_memory.h"
+#include "numa_bfs.h"
+#include "parallel_backend.h"
+#include "partition.h"
+#include "simd_kernels.h"
+#include "sssp.h"
+#include "thread_pool.h"
+#include "topology.h"
+#include "workspace.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+// Behavior checks for the engines and loaders. Each case prints the checks
+// it failed; the exit status is the number of failed cases. Arguments pick
+// the cases whose names start with one of them.
+
+namespace {
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::cerr << "  " << __FILE__ << ":" << __LINE__ << ": " << #cond << "\n"; \
+            ok = false;                                                               \
+        }                                                                             \
+    } while (0)
+
+struct Edge {
+    int u, v;
+    float w;
+};
+
+// CSR with every list sorted; `symmetric` adds each edge in both directions
+Graph make_graph(size_t V, std::vector<Edge> list, bool symmetric, bool weighted = false) {
+    if (symmetric) {
+        const size_t n = list.size();
+        for (size_t i = 0; i < n; ++i) list.push_back({list[i].v, list[i].u, list[i].w});
+    }
+    std::sort(list.begin(), list.end(), [](const Edge& a, const Edge& b) {
+        return std::tie(a.u, a.v) < std::tie(b.u, b.v);
+    });
+    list.erase(std::unique(list.begin(), list.end(), [](const Edge& a, const Edge& b) {
+        return a.u == b.u && a.v == b.v;
+    }), list.end());
+
+    std::vector<int> offsets(V + 1, 0), edges;
+    std::vector<float> weights;
+    for (const Edge& e : list) {
+        offsets[e.u + 1]++;
+        edges.push_back(e.v);
+        if (weighted) weights.push_back(e.w);
+    }
+    for (size_t u = 0; u < V; ++u) offsets[u + 1] += offsets[u];
+    return Graph(std::move(offsets), std::move(edges), std::move(weights));
+}
+
+std::vector<Edge> random_edges(size_t V, size_t E, int max_weight, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, static_cast<int>(V) - 1), weight(0, max_weight);
+    std::vector<Edge> list;
+    for (size_t i = 0; i < E; ++i) {
+        const int u = vertex(gen), v = vertex(gen);
+        if (u != v) list.push_back({u, v, static_cast<float>(weight(gen))});
+    }
+    return list;
+}
+
+std::vector<Edge> cycle(int n) {
+    std::vector<Edge> list;
+    for (int i = 0; i < n; ++i) list.push_back({i, (i + 1) % n, 1});
+    return list;
+}
+
+std::vector<double> dijkstra(const Graph& g, int source) {
+    std::vector<double> dist(g.vertex_count(), INFINITY);
+    using Item = std::pair<double, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    dist[source] = 0;
+    queue.push({0, source});
+    while (!queue.empty()) {
+        const auto [d, u] = queue.top();
+        queue.pop();
+        if (d > dist[u]) continue;
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            const double next = d + g.weights[e];
+            if (next < dist[g.edges[e]]) {
+                dist[g.edges[e]] = next;
+                queue.push({next, g.edges[e]});
+            }
+        }
+    }
+    return dist;
+}
+
+bool has_edge(const Graph& g, int u, int v) {
+    return std::binary_search(g.edges.begin() + g.offsets[u], g.edges.begin() + g.offsets[u + 1], v);
+}
+
+// Scratch file in the working directory, unique per process
+std::string temp_file(const char* extension) {
+    return "test_cases_" + std::to_string(getpid()) + extension;
+}
+
+template <typename Fn>
+bool throws(Fn&& fn) {
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+bool test_bipartite() {
+    bool ok = true;
+    for (int n : {4, 6, 64}) {
+        const Graph g = make_graph(n, cycle(n), true);
+        const ParallelBFS::BipartiteResult result = ParallelBFS::bipartite(g);
+        CHECK(result.bipartite);
+        CHECK(result.color.size() == static_cast<size_t>(n));
+        for (int i = 0; ok && i < n; ++i) CHECK(result.color[i] != result.color[(i + 1) % n]);
+    }
+    for (int n : {3, 5, 63}) {
+        const Graph g = make_graph(n, cycle(n), true);
+        const ParallelBFS::BipartiteResult result = ParallelBFS::bipartite(g);
+        CHECK(!result.bipartite);
+        const std::vector<int>& witness = result.odd_cycle;
+        CHECK(witness.size() % 2 == 1);
+        for (size_t i = 0; ok && i < witness.size(); ++i) {
+            CHECK(has_edge(g, witness[i], witness[(i + 1) % witness.size()]));
+        }
+    }
+
+    // One direction of an even cycle is not an undirected graph
+    CHECK(throws([] { ParallelBFS::bipartite(make_graph(6, cycle(6), false)); }));
+
+    // Random edges between even and odd vertices, over several components
+    std::vector<Edge> list = random_edges(2000, 3000, 1, 76);
+    for (Edge& e : list) e.v ^= (e.u ^ e.v ^ 1) & 1;
+    const Graph g = make_graph(2000, list, true);
+    const ParallelBFS::BipartiteResult result = ParallelBFS::bipartite(g);
+    CHECK(result.bipartite);
+    for (size_t u = 0; ok && u < g.vertex_count(); ++u) {
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) CHECK(result.color[u] != result.color[g.edges[e]]);
+    }
+    return ok;
+}
+
+bool test_delta_stepping() {
+    bool ok = true;
+    const size_t V = 2000;
+    // The last 100 vertices have no edges and stay unreachable; some edges weigh 0
+    const Graph g = make_graph(V, random_edges(V - 100, 12000, 9, 77), false, true);
+    const std::vector<double> expected = dijkstra(g, 0);
+
+    for (float delta : {0.0f, 1.0f, 4.0f, 100.0f}) {
+        std::vector<std::atomic<float>> dist(V);
+        ParallelBFS::delta_stepping(g, 0, dist, delta);
+        size_t wrong = 0;
+        for (size_t v = 0; v < V; ++v) wrong += dist[v].load() != static_cast<float>(expected[v]);
+        CHECK(wrong == 0);
+    }
+
+    for (float bad : {-1.0f, NAN, INFINITY}) {
+        std::vector<Edge> list = random_edges(100, 500, 9, 78);
+        list[7].w = bad;
+        const Graph h = make_graph(100, list, false, true);
+        std::vector<std::atomic<float>> dist(100);
+        CHECK(throws([&] { ParallelBFS::delta_stepping(h, 0, dist); }));
+    }
+    return ok;
+}
+
+bool test_weighted_file() {
+    bool ok = true;
+    const std::string file = temp_file(".txt");
+
+    // Sources out of order, and lists in neither ascending nor file-wide order
+    const std::vector<Edge> list = {{3, 1, 5}, {0, 2, 1}, {3, 0, 7}, {1, 3, 2}, {0, 1, 4},
+                                    {2, 0, 3}, {3, 2, 6}, {0, 3, 8}, {1, 0, 9}};
+    {
+        std::ofstream out(file);
+        out << "# unsorted, weighted\n";
+        for (const Edge& e : list) out << e.u << " " << e.v << " " << e.w << "\n";
+    }
+    const Graph g = GraphGenerator::from_file(file);
+    CHECK(g.vertex_count() == 4 && g.edge_count() == list.size());
+    CHECK(g.weighted());
+    for (int u = 0; u < 4; ++u) {
+        // Every list keeps its edges in file order, each with its own weight
+        std::vector<std::pair<int, float>> want, got;
+        for (const Edge& e : list) {
+            if (e.u == u) want.push_back({e.v, e.w});
+        }
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) got.push_back({g.edges[e], g.weights[e]});
+        CHECK(got == want);
+    }
+
+    // Mixed column counts, extra columns and weights no SSSP engine can use
+    for (const char* bad : {"0 1 2\n1 2\n", "0 1\n1 2 3\n", "0 1 2 3\n", "0 1 -1\n", "0 1 nan\n", "0 1 inf\n"}) {
+        std::ofstream(file) << bad;
+        CHECK(throws([&] { GraphGenerator::from_file(file); }));
+    }
+    std::remove(file.c_str());
+    return ok;
+}
+
+bool test_dial() {
+    bool ok = true;
+    const size_t V = 2000;
+    // 0-1 weights, and small integers with zeros among them
+    for (int max_weight : {1, 9}) {
+        const Graph g = make_graph(V, random_edges(V - 100, 12000, max_weight, 78), false, true);
+        const std::vector<double> expected = dijkstra(g, 0);
+        std::vector<std::atomic<int>> dist(V);
+        ParallelBFS::dial_bfs(g, ParallelBFS::small_integer_weights(g), 0, dist);
+        size_t wrong = 0;
+        for (size_t v = 0; v < V; ++v) {
+            wrong += dist[v].load() != (std::isinf(expected[v]) ? INT_MAX : static_cast<int>(expected[v]));
+        }
+        CHECK(wrong == 0);
+    }
+
+    for (float bad : {256.0f, 1.5f, -1.0f, NAN}) {
+        std::vector<Edge> list = random_edges(100, 500, 9, 79);
+        list[3].w = bad;
+        const Graph g = make_graph(100, list, false, true);
+        CHECK(throws([&] { ParallelBFS::small_integer_weights(g); }));
+    }
+    return ok;
+}
+
+// Sequential BFS levels from every source; distances[s][v] is -1 when unreachable
+std::vector<std::vector<int>> all_distances(const Graph& g) {
+    const size_t V = g.vertex_count();
+    std::vector<std::vector<int>> distances(V, std::vector<int>(V, -1));
+    for (size_t s = 0; s < V; ++s) {
+        std::vector<int>& dist = distances[s];
+        std::queue<int> queue;
+        dist[s] = 0;
+        queue.push(static_cast<int>(s));
+        while (!queue.empty()) {
+            const int u = queue.front();
+            queue.pop();
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                if (dist[g.edges[e]] < 0) {
+                    dist[g.edges[e]] = dist[u] + 1;
+                    queue.push(g.edges[e]);
+                }
+            }
+        }
+    }
+    return distances;
+}
+
+bool test_hyperanf() {
+    bool ok = true;
+    const size_t V = 1000;
+    const Graph g = make_graph(V, random_edges(V, 1500, 1, 79), false);
+
+    // Exact pairs within t hops
+    std::vector<double> exact;
+    for (const std::vector<int>& row : all_distances(g)) {
+        for (int d : row) {
+            if (d < 0) continue;
+            if (exact.size() <= static_cast<size_t>(d)) exact.resize(d + 1, 0);
+            exact[d]++;
+        }
+    }
+    for (size_t t = 1; t < exact.size(); ++t) exact[t] += exact[t - 1];
+
+    ParallelBFS::HyperANFConfig config;
+    config.log2_registers = 10;
+    const ParallelBFS::NeighborhoodFunction estimate = ParallelBFS::hyperanf(g, config);
+    CHECK(estimate.log2_registers == 10);
+    CHECK(!estimate.pairs_within.empty());
+    for (size_t t = 0; t < exact.size(); ++t) {
+        const double got = estimate.pairs_within[std::min(t, estimate.pairs_within.size() - 1)];
+        CHECK(std::abs(got - exact[t]) <= 0.1 * exact[t]);
+    }
+
+    // The memory cap lowers the register count, and refuses to go below the minimum
+    config.memory_limit_bytes = 2 * V * 64;
+    CHECK(ParallelBFS::hyperanf(g, config).log2_registers == 6);
+    config.memory_limit_bytes = V;
+    CHECK(throws([&] { ParallelBFS::hyperanf(g, config); }));
+    return ok;
+}
+
+bool test_apsp() {
+    bool ok = true;
+    // A random digraph, and a path long enough to saturate the byte distances
+    std::vector<Edge> path;
+    for (int i = 0; i + 1 < 300; ++i) path.push_back({i, i + 1, 1});
+    for (const Graph& g : {make_graph(700, random_edges(700, 2100, 1, 80), false), make_graph(300, path, false)}) {
+        const std::vector<std::vector<int>> expected = all_distances(g);
+        const size_t V = g.vertex_count();
+        for (size_t batch : {size_t(64), size_t(512)}) {
+            for (size_t tile : {size_t(0), size_t(16)}) {
+                const ParallelBFS::DistanceMatrix matrix = ParallelBFS::all_pairs_bfs(g, batch, tile);
+                CHECK(matrix.n == V);
+                size_t wrong = 0;
+                for (size_t s = 0; s < V; ++s) {
+                    for (size_t t = 0; t < V; ++t) {
+                        const int d = expected[s][t];
+                        const int want = d < 0 ? ParallelBFS::DistanceMatrix::UNREACHABLE : std::min(d, 254);
+                        wrong += matrix.at(s, t) != want;
+                    }
+                }
+                CHECK(wrong == 0);
+            }
+        }
+    }
+
+    const Graph too_big(std::vector<int>(ParallelBFS::MAX_APSP_VERTICES + 2, 0), std::vector<int>());
+    CHECK(throws([&] { ParallelBFS::all_pairs_bfs(too_big); }));
+    return ok;
+}
+
+// Coreness by repeatedly removing a vertex of minimum remaining degree
+std::vector<int> reference_coreness(const Graph& g) {
+    const size_t V = g.vertex_count();
+    std::vector<int> degree(V), coreness(V, -1);
+    for (size_t u = 0; u < V; ++u) degree[u] = g.offsets[u + 1] - g.offsets[u];
+    int k = 0;
+    for (size_t removed = 0; removed < V; ++removed) {
+        size_t best = V;
+        for (size_t u = 0; u < V; ++u) {
+            if (coreness[u] < 0 && (best == V || degree[u] < degree[best])) best = u;
+        }
+        k = std::max(k, degree[best]);
+        coreness[best] = k;
+        for (int e = g.offsets[best]; e < g.offsets[best + 1]; ++e) degree[g.edges[e]]--;
+    }
+    return coreness;
+}
+
+bool test_kcore() {
+    bool ok = true;
+    // K5 on 0-4 with a tail 4-9-10, a separate 4-cycle on 5-8 and isolated vertex 11
+    std::vector<Edge> list;
+    for (int a = 0; a < 5; ++a) {
+        for (int b = a + 1; b < 5; ++b) list.push_back({a, b, 1});
+    }
+    for (int i = 0; i < 4; ++i) list.push_back({5 + i, 5 + (i + 1) % 4, 1});
+    list.insert(list.end(), {{4, 9, 1}, {9, 10, 1}});
+    const Graph known = make_graph(12, list, true);
+    const ParallelBFS::CoreDecomposition cores = ParallelBFS::kcore(known);
+    CHECK(cores.coreness == std::vector<int>({4, 4, 4, 4, 4, 2, 2, 2, 2, 1, 1, 0}));
+    CHECK(cores.degeneracy == 4);
+
+    const Graph g = make_graph(1500, random_edges(1500, 6000, 1, 81), true);
+    const ParallelBFS::CoreDecomposition result = ParallelBFS::kcore(g);
+    CHECK(result.coreness == reference_coreness(g));
+    CHECK(result.degeneracy == *std::max_element(result.coreness.begin(), result.coreness.end()));
+
+    // A degeneracy ordering: a permutation in which no vertex has more than
+    // its coreness neighbors left once it is peeled
+    std::vector<int> position(g.vertex_count(), -1);
+    for (size_t i = 0; i < result.order.size(); ++i) position[result.order[i]] = static_cast<int>(i);
+    CHECK(result.order.size() == g.vertex_count());
+    CHECK(std::count(position.begin(), position.end(), -1) == 0);
+    for (size_t u = 0; ok && u < g.vertex_count(); ++u) {
+        int later = 0;
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) later += position[g.edges[e]] > position[u];
+        CHECK(later <= result.coreness[u]);
+    }
+
+    CHECK(throws([] { ParallelBFS::kcore(make_graph(6, cycle(6), false)); }));
+    return ok;
+}
+
+bool test_partition() {
+    bool ok = true;
+    const Graph g = make_graph(3000, random_edges(3000, 15000, 1, 82), true);
+    const size_t V = g.vertex_count(), E = g.edge_count();
+
+    for (ParallelBFS::InitialSplit initial : {ParallelBFS::InitialSplit::Block, ParallelBFS::InitialSplit::Degree}) {
+        ParallelBFS::PartitionConfig config;
+        config.parts = 4;
+        config.initial = initial;
+        const ParallelBFS::Partition p = ParallelBFS::partition(g, config);
+
+        // new_id is a permutation that keeps every partition contiguous
+        std::vector<int> seen(V, 0);
+        std::vector<size_t> part_edges(config.parts, 0);
+        size_t cut = 0, misplaced = 0;
+        CHECK(p.part.size() == V && p.new_id.size() == V && p.part_offsets.size() == 5);
+        for (size_t v = 0; v < V; ++v) {
+            const bool in_range = p.part[v] >= 0 && p.part[v] < config.parts && p.new_id[v] >= 0 &&
+                                  static_cast<size_t>(p.new_id[v]) < V;
+            CHECK(in_range);
+            if (!in_range) return false;
+            misplaced += p.new_id[v] < p.part_offsets[p.part[v]] || p.new_id[v] >= p.part_offsets[p.part[v] + 1];
+            seen[p.new_id[v]]++;
+            part_edges[p.part[v]] += g.offsets[v + 1] - g.offsets[v];
+            for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) cut += p.part[v] != p.part[g.edges[e]];
+        }
+        CHECK(misplaced == 0);
+        CHECK(std::count(seen.begin(), seen.end(), 1) == static_cast<long>(V));
+        CHECK(p.part_edges == part_edges);
+        CHECK(p.edge_cut == cut);
+        const double heaviest = static_cast<double>(*std::max_element(part_edges.begin(), part_edges.end()));
+        CHECK(std::abs(p.imbalance - heaviest / (static_cast<double>(E) / config.parts)) < 1e-9);
+
+        // The relabeled graph is the same graph under new names
+        const Graph r = ParallelBFS::relabel(g, p.new_id);
+        CHECK(r.vertex_count() == V && r.edge_count() == E);
+        std::vector<std::atomic<int>> dist(V), renamed(V);
+        ParallelBFS::baseline(g, 0, dist);
+        ParallelBFS::baseline(r, p.new_id[0], renamed);
+        size_t wrong = 0;
+        for (size_t v = 0; v < V; ++v) wrong += dist[v].load() != renamed[p.new_id[v]].load();
+        CHECK(wrong == 0);
+        size_t moved = 0;
+        for (size_t v = 0; v < V; ++v) {
+            const int u = p.new_id[v];
+            std::vector<int> want, got(r.edges.begin() + r.offsets[u], r.edges.begin() + r.offsets[u + 1]);
+            for (int e = g.offsets[v]; e < g.offsets[v + 1]; ++e) want.push_back(p.new_id[g.edges[e]]);
+            std::sort(want.begin(), want.end());
+            std::sort(got.begin(), got.end());
+            moved += got != want;
+        }
+        CHECK(moved == 0);
+    }
+
+    // Wrong length, out of range, and a repeated ID
+    std::vector<int> identity(V);
+    for (size_t v = 0; v < V; ++v) identity[v] = static_cast<int>(v);
+    std::vector<int> short_ids(identity.begin(), identity.end() - 1), out_of_range = identity, repeated = identity;
+    out_of_range[5] = static_cast<int>(V);
+    repeated[5] = 6;
+    for (const std::vector<int>* bad : {&short_ids, &out_of_range, &repeated}) {
+        CHECK(throws([&] { ParallelBFS::relabel(g, *bad); }));
+    }
+    return ok;
+}
+
+bool test_distance_histogram() {
+    bool ok = true;
+    const size_t V = 800;
+    const Graph g = make_graph(V, random_edges(V, 1600, 1, 83), false);
+
+    std::vector<size_t> exact;
+    for (const std::vector<int>& row : all_distances(g)) {
+        for (int d : row) {
+            if (d < 0) continue;
+            if (exact.size() <= static_cast<size_t>(d)) exact.resize(d + 1, 0);
+            exact[d]++;
+        }
+    }
+    size_t reachable = 0, distance_sum = 0, median = 0, seen = 0;
+    for (size_t d = 1; d < exact.size(); ++d) {
+        reachable += exact[d];
+        distance_sum += d * exact[d];
+    }
+    for (size_t d = 1; median == 0 && d < exact.size(); ++d) {
+        seen += exact[d];
+        if (2 * seen >= reachable) median = d;
+    }
+
+    // Every vertex is a source once samples reaches V
+    for (size_t samples : {V, V + 10}) {
+        const ParallelBFS::DistanceHistogram h = ParallelBFS::distance_histogram(g, samples);
+        CHECK(h.samples == V);
+        CHECK(h.level_counts == exact);
+        CHECK(h.reachable_pairs == reachable);
+        CHECK(std::abs(h.mean_distance - static_cast<double>(distance_sum) / reachable) < 1e-9);
+        CHECK(h.median_distance == static_cast<int>(median));
+        CHECK(std::abs(h.reachable_fraction - reachable / (static_cast<double>(V) * (V - 1))) < 1e-12);
+    }
+
+    const ParallelBFS::DistanceHistogram sampled = ParallelBFS::distance_histogram(g, 50);
+    CHECK(sampled.samples == 50 && !sampled.level_counts.empty() && sampled.level_counts[0] == 50);
+    return ok;
+}
+
+bool test_thread_pool() {
+    bool ok = true;
+    for (size_t threads : {1, 3, 4}) {
+        ThreadPool pool(threads);
+        CHECK(pool.size() == threads);
+
+        // Every index exactly once, whatever the grain and stealing
+        for (size_t n : {0, 1, 1000, 100003}) {
+            for (size_t grain : {1, 64, 5000}) {
+                std::vector<std::atomic<int>> hits(n);
+                for (auto& h : hits) h.store(0);
+                pool.parallel_for(n, grain, [&](size_t begin, size_t end, size_t worker) {
+                    // A worker index past the pool's size counts as a miss
+                    for (size_t i = begin; worker < threads && i < end; ++i) hits[i].fetch_add(1);
+                });
+                size_t wrong = 0;
+                for (auto& h : hits) wrong += h.load() != 1;
+                CHECK(wrong == 0);
+            }
+        }
+
+        // No worker passes a barrier before all have arrived
+        std::atomic<size_t> arrived{0}, early{0};
+        pool.run([&](size_t) {
+            for (size_t phase = 1; phase <= 50; ++phase) {
+                arrived.fetch_add(1);
+                pool.barrier();
+                if (arrived.load() < phase * threads) early.fetch_add(1);
+                pool.barrier();
+            }
+        });
+        CHECK(early.load() == 0);
+
+        const Graph g = make_graph(5000, random_edges(5000, 20000, 1, 84), false);
+        std::vector<std::atomic<int>> expected(5000), dist(5000);
+        ParallelBFS::baseline(g, 0, expected);
+        ParallelBFS::optimized(g, 0, dist, pool);
+        CHECK(ParallelBFS::get_distances(dist) == ParallelBFS::get_distances(expected));
+    }
+    return ok;
+}
+
+bool test_frontier_bag() {
+    bool ok = true;
+    FrontierBag bag(Parallel::max_threads());
+    // Across several chunks per thread, then again after clear() recycles them
+    for (size_t n : {size_t(0), size_t(10), size_t(50000), size_t(3000)}) {
+        Parallel::for_chunks(n, 100, [&](size_t begin, size_t end, size_t thread) {
+            for (size_t i = begin; i < end; ++i) bag.insert(thread, static_cast<int>(i));
+        });
+        bag.seal();
+        CHECK(bag.size() == n && bag.empty() == (n == 0));
+
+        std::vector<int> items;
+        for (const FrontierBag::Range& range : bag.ranges()) {
+            CHECK(range.end > range.begin && static_cast<size_t>(range.end - range.begin) <= FrontierBag::SPLIT_SIZE);
+            items.insert(items.end(), range.begin, range.end);
+        }
+        std::sort(items.begin(), items.end());
+        size_t wrong = items.size() != n;
+        for (size_t i = 0; i < items.size(); ++i) wrong += items[i] != static_cast<int>(i);
+        CHECK(wrong == 0);
+        bag.clear();
+        CHECK(bag.empty());
+    }
+
+    // optimized() runs its levels on bags
+    const Graph g = make_graph(20000, random_edges(20000, 100000, 1, 85), false);
+    std::vector<std::atomic<int>> expected(20000), dist(20000);
+    ParallelBFS::baseline(g, 0, expected);
+    ParallelBFS::optimized(g, 0, dist);
+    CHECK(ParallelBFS::get_distances(dist) == ParallelBFS::get_distances(expected));
+    return ok;
+}
+
+bool test_topology() {
+    bool ok = true;
+    // Two nodes of two cores with two SMT siblings each, numbered as Linux
+    // does: CPUs 0-3 are the first sibling of cores 0-3, CPUs 4-7 the second
+    Topology::CpuTopology topology;
+    for (int id = 0; id < 8; ++id) topology.cpus.push_back({id, id % 4, (id % 4) / 2, (id % 4) / 2});
+    topology.cores = 4;
+    topology.packages = topology.nodes = 2;
+    using Topology::PinPolicy;
+    CHECK(Topology::placement(topology, PinPolicy::Compact, 8) == std::vector<int>({0, 4, 1, 5, 2, 6, 3, 7}));
+    CHECK(Topology::placement(topology, PinPolicy::Scatter, 8) == std::vector<int>({0, 2, 1, 3, 4, 6, 5, 7}));
+    CHECK(Topology::placement(topology, PinPolicy::OnePerCore, 6) == std::vector<int>({0, 1, 2, 3, 0, 1}));
+    CHECK(Topology::placement(topology, PinPolicy::None, 8).empty());
+    CHECK(Topology::parse_policy("core") == PinPolicy::OnePerCore);
+    CHECK(throws([] { Topology::parse_policy("spread"); }));
+
+    // Pinning the backend's workers leaves the calling thread's mask alone
+    const std::vector<int> before = Topology::current_affinity();
+    for (PinPolicy policy : {PinPolicy::Compact, PinPolicy::Scatter, PinPolicy::OnePerCore}) {
+        Topology::pin_worker_threads(policy);
+        CHECK(Topology::current_affinity() == before);
+    }
+    // Unpin again for the cases that follow
+    Parallel::region([&](size_t, size_t) { Topology::set_current_affinity(before); });
+    return ok;
+}
+
+// Distances the reference BFS finds from `source`
+std::vector<int> baseline_distances(const Graph& g, int source) {
+    std::vector<std::atomic<int>> dist(g.vertex_count());
+    ParallelBFS::baseline(g, source, dist);
+    return ParallelBFS::get_distances(dist);
+}
+
+bool test_numa_bfs() {
+    bool ok = true;
+    const Graph g = make_graph(20000, random_edges(20000, 80000, 1, 87), false);
+    const size_t V = g.vertex_count();
+    // More nodes than the machine has still takes the mailbox path, unpinned
+    for (size_t nodes : {1, 2, 3, 4}) {
+        ParallelBFS::NumaBFS engine(g, nodes, 4);
+        CHECK(engine.nodes() == nodes);
+        size_t backwards = 0;
+        for (size_t v = 1; v < V; ++v) backwards += engine.owner(v) < engine.owner(v - 1);
+        CHECK(backwards == 0 && engine.owner(0) == 0 && engine.owner(V - 1) == nodes - 1);
+        for (int source : {0, 777, 19999}) {
+            std::vector<std::atomic<int>> dist(V);
+            engine.run(source, dist);
+            CHECK(ParallelBFS::get_distances(dist) == baseline_distances(g, source));
+        }
+    }
+    return ok;
+}
+
+bool test_async_bfs() {
+    bool ok = true;
+    // A path with random shortcuts: many vertices are first reached the long way round
+    std::vector<Edge> list = random_edges(20000, 30000, 1, 88);
+    for (int i = 0; i + 1 < 20000; ++i) list.push_back({i, i + 1, 1});
+    const Graph g = make_graph(20000, list, false);
+    for (size_t threads : {1, 4}) {
+        ThreadPool pool(threads);
+        for (int width : {1, 2, 16}) {
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            ParallelBFS::async_bfs(g, 0, dist, pool, width);
+            CHECK(ParallelBFS::get_distances(dist) == baseline_distances(g, 0));
+        }
+        std::vector<std::atomic<int>> dist(g.vertex_count());
+        CHECK(throws([&] { ParallelBFS::async_bfs(g, 0, dist, pool, 0); }));
+    }
+    return ok;
+}
+
+bool test_parallel_backend() {
+    bool ok = true;
+#if defined(BFS_BACKEND_OPENMP)
+    CHECK(std::string(Parallel::backend_name()) == "openmp");
+#elif defined(BFS_BACKEND_THREADS)
+    CHECK(std::string(Parallel::backend_name()) == "threads");
+#else
+    CHECK(std::string(Parallel::backend_name()) == "serial" && Parallel::max_threads() == 1);
+#endif
+    const size_t T = Parallel::max_threads();
+
+    // Every thread index passed in stays below max_threads()
+    std::vector<std::atomic<int>> ran(T);
+    for (auto& r : ran) r.store(0);
+    Parallel::region([&](size_t thread, size_t threads) {
+        if (thread < T && threads <= T) ran[thread].fetch_add(1);
+    });
+    CHECK(ran[0].load() == 1);
+
+    for (size_t n : {0, 1, 999, 100000}) {
+        for (size_t grain : {0, 1, 128}) {
+            std::vector<std::atomic<int>> hits(n);
+            for (auto& h : hits) h.store(0);
+            std::atomic<size_t> bad_thread{0};
+            Parallel::for_chunks(n, grain, [&](size_t begin, size_t end, size_t thread) {
+                bad_thread += thread >= T || begin >= end || end > n;
+                for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+            });
+            size_t wrong = 0;
+            for (auto& h : hits) wrong += h.load() != 1;
+            CHECK(wrong == 0 && bad_thread.load() == 0);
+
+            const size_t total = Parallel::sum<size_t>(n, [](size_t i) { return i; }, grain);
+            CHECK(total == (n == 0 ? 0 : n * (n - 1) / 2));
+            const size_t biggest = Parallel::reduce(n, size_t(0), [](size_t i) { return (i * 7919) % 100003; },
+                                                    [](size_t a, size_t b) { return std::max(a, b); }, grain);
+            size_t expected = 0;
+            for (size_t i = 0; i < n; ++i) expected = std::max(expected, (i * 7919) % 100003);
+            CHECK(biggest == expected);
+        }
+    }
+
+    // Nested calls run inline rather than deadlocking
+    const size_t nested = Parallel::sum<size_t>(64, [](size_t) { return Parallel::sum<size_t>(10, [](size_t) { return 1; }); }, 1);
+    CHECK(nested == 640);
+
+    std::vector<int> blocks = {3, 0, 5, 2};
+    CHECK(Parallel::exclusive_scan(blocks) == 10 && blocks == std::vector<int>({0, 3, 3, 8}));
+    return ok;
+}
+
+bool test_simd_kernels() {
+    bool ok = true;
+    std::cout << "  kernels: " << Kernels::isa() << "\n";
+    std::mt19937_64 gen(90);
+    for (size_t words : {1, 3, 8, 17, 64, 1000}) {
+        // Sparse, dense and empty bitmaps
+        for (int density : {0, 1, 8, 64}) {
+            std::vector<uint64_t> bitmap(words);
+            for (uint64_t& w : bitmap) {
+                w = 0;
+                for (int k = 0; k < density; ++k) w |= uint64_t(1) << (gen() % 64);
+            }
+            // Every [first, last) window, so misaligned heads and tails are covered
+            for (size_t first = 0; first < std::min<size_t>(words, 9); ++first) {
+                for (size_t last = first; last <= words; last += 1 + last / 4) {
+                    std::vector<int> expected;
+                    for (size_t i = first * 64; i < last * 64; ++i) {
+                        if (bitmap[i / 64] >> (i % 64) & 1) expected.push_back(static_cast<int>(i));
+                    }
+                    CHECK(Kernels::popcount(bitmap.data(), first, last) == expected.size());
+                    std::vector<int> list(expected.size());
+                    CHECK(Kernels::bitmap_to_list(bitmap.data(), first, last, list.data()) == expected.size());
+                    CHECK(list == expected);
+                }
+            }
+
+            // Lists of IDs of every length up to a few vectors, with the hit anywhere or nowhere
+            const int V = static_cast<int>(std::min<size_t>(words * 64, 65536));
+            for (size_t n : {0, 1, 7, 8, 15, 16, 33, 100}) {
+                std::vector<int> ids(n);
+                std::vector<uint16_t> narrow(n);
+                for (size_t i = 0; i < n; ++i) narrow[i] = static_cast<uint16_t>(ids[i] = static_cast<int>(gen() % V));
+                size_t expected = n;
+                for (size_t i = 0; i < n && expected == n; ++i) {
+                    if (bitmap[ids[i] / 64] >> (ids[i] % 64) & 1) expected = i;
+                }
+                CHECK(Kernels::first_in_bitmap(ids.data(), n, bitmap.data()) == expected);
+                CHECK(Kernels::first_in_bitmap(narrow.data(), n, bitmap.data()) == expected);
+            }
+        }
+    }
+    return ok;
+}
+
+bool test_hybrid_bfs() {
+    bool ok = true;
+    // Dense enough that the search switches to bottom-up, where the kernels run
+    const size_t V = 30000;
+    const Graph g = make_graph(V, random_edges(V, V * 16, 1, 90), true);
+    ParallelBFS::HybridBFS hybrid(g);
+    for (int source : {0, 12345}) {
+        std::vector<std::atomic<int>> dist(V);
+        hybrid.run(source, dist);
+        CHECK(hybrid.bottom_up_levels() > 0);
+        CHECK(ParallelBFS::get_distances(dist) == baseline_distances(g, source));
+    }
+    return ok;
+}
+
+bool test_prefetch() {
+    bool ok = true;
+    // Frontiers both shorter and far longer than the prefetch distance
+    const Graph g = make_graph(20000, random_edges(20000, 60000, 1, 91), false);
+    const std::vector<int> expected = baseline_distances(g, 0);
+    ThreadPool pool(3);
+    for (int distance : {0, 1, 2, 16, 64, 1000}) {
+        std::vector<std::atomic<int>> dist(g.vertex_count()), pooled(g.vertex_count());
+        ParallelBFS::optimized(g, 0, dist, distance);
+        ParallelBFS::optimized(g, 0, pooled, pool, distance);
+        CHECK(ParallelBFS::get_distances(dist) == expected);
+        CHECK(ParallelBFS::get_distances(pooled) == expected);
+    }
+    return ok;
+}
+
+bool test_binned_bfs() {
+    bool ok = true;
+    const Graph g = make_graph(50000, random_edges(50000, 200000, 1, 92), false);
+    // Bins below a bitmap word (rounded up to 64), several sizes, the default, and one bin for everything
+    for (size_t bin : {size_t(1), size_t(64), size_t(1000), size_t(0), size_t(1) << 20}) {
+        for (int source : {0, 4321}) {
+            std::vector<std::atomic<int>> dist(g.vertex_count());
+            ParallelBFS::binned_bfs(g, source, dist, bin);
+            CHECK(ParallelBFS::get_distances(dist) == baseline_distances(g, source));
+        }
+    }
+    return ok;
+}
+
+// Runs `engine` on `ranks` forked processes and returns rank 0's distances, or nothing if a rank failed
+template <typename Engine>
+std::vector<int> distributed_distances(const Graph& g, int source, int ranks, Distributed::TransportKind kind,
+                                       Engine&& engine) {
+    Distributed::SharedBuffer returned(g.vertex_count() * sizeof(int));
+    const int status = Distributed::launch(ranks, kind, [&](Distributed::Transport& t) {
+        const ParallelBFS::DistributedResult result = engine(g, source, t);
+        if (t.rank() != 0) return 0;
+        if (result.dist.size() != g.vertex_count()) return 1;
+        std::copy(result.dist.begin(), result.dist.end(), reinterpret_cast<int*>(returned.data()));
+        return 0;
+    });
+    if (status != 0) return {};
+    const int* dist = reinterpret_cast<const int*>(returned.data());
+    return std::vector<int>(dist, dist + g.vertex_count());
+}
+
+bool test_distributed_bfs() {
+    bool ok = true;
+    using Distributed::TransportKind;
+    for (TransportKind kind : {TransportKind::SharedMemory, TransportKind::Socket}) {
+        // Collectives: every rank addresses a distinct message to every rank
+        const int status = Distributed::launch(4, kind, [](Distributed::Transport& t) {
+            std::vector<std::vector<int>> out(t.size());
+            for (int r = 0; r < t.size(); ++r) out[r] = std::vector<int>(r + 1, t.rank() * 100 + r);
+            const std::vector<std::vector<int>> in = t.exchange_ints(out);
+            int bad = static_cast<int>(in.size()) != t.size();
+            for (int r = 0; !bad && r < t.size(); ++r) bad = in[r] != std::vector<int>(t.rank() + 1, r * 100 + t.rank());
+            bad |= t.all_reduce_sum(t.rank()) != 6 || t.all_reduce_max(t.rank() * 3) != 9;
+            t.barrier();
+            return bad;
+        });
+        CHECK(status == 0);
+
+        const Graph g = make_graph(20000, random_edges(20000, 80000, 1, 93), false);
+        for (int ranks : {1, 2, 3, 4}) {
+            for (int source : {0, 15000}) {
+                CHECK(distributed_distances(g, source, ranks, kind, ParallelBFS::distributed_bfs) ==
+                      baseline_distances(g, source));
+            }
+        }
+    }
+    return ok;
+}
+
+bool test_distributed_bfs_2d() {
+    bool ok = true;
+    CHECK(ParallelBFS::grid_shape(1) == std::make_pair(1, 1));
+    CHECK(ParallelBFS::grid_shape(4) == std::make_pair(2, 2));
+    CHECK(ParallelBFS::grid_shape(6) == std::make_pair(2, 3));
+    CHECK(ParallelBFS::grid_shape(7) == std::make_pair(1, 7));
+    CHECK(ParallelBFS::grid_shape(12) == std::make_pair(3, 4));
+
+    // Sparse frontiers travel as gap lists, dense ones as bitmaps; a hub spreads over a grid column
+    std::vector<Edge> hub = random_edges(20000, 20000, 1, 94);
+    for (int v = 1; v < 20000; v += 3) hub.push_back({0, v, 1});
+    const Graph graphs[] = {make_graph(20000, random_edges(20000, 30000, 1, 94), false),
+                            make_graph(5000, random_edges(5000, 100000, 1, 95), false),
+                            make_graph(20000, hub, true)};
+    using Distributed::TransportKind;
+    for (TransportKind kind : {TransportKind::SharedMemory, TransportKind::Socket}) {
+        for (const Graph& g : graphs) {
+            for (int ranks : {1, 2, 4, 6}) {
+                CHECK(distributed_distances(g, 1, ranks, kind, ParallelBFS::distributed_bfs_2d) ==
+                      baseline_distances(g, 1));
+            }
+        }
+    }
+    return ok;
+}
+
+bool test_workspace() {
+    bool ok = true;
+    Workspace::release_idle();
+    Workspace* first = nullptr;
+    {
+        Workspace::Lease lease(4);
+        first = &*lease;
+        CHECK(lease->threads() >= 4);
+        for (size_t t = 0; t < 4; ++t) lease->local(t).assign(1000 + t, static_cast<int>(t));
+        lease->frontier(0).assign(5000, 7);
+
+        std::vector<int> out = {-1};
+        lease->drain_locals(out);
+        CHECK(out.size() == 1 + 1000 + 1001 + 1002 + 1003 && out[0] == -1 && out[1] == 0 && out.back() == 3);
+        CHECK(lease->local(2).empty());
+
+        // A nested lease gets a workspace of its own
+        Workspace::Lease nested(4);
+        CHECK(&*nested != first);
+    }
+    {
+        // The outer workspace went back last, so it comes out first: emptied, capacity kept
+        Workspace::Lease reused(4);
+        CHECK(&*reused == first);
+        CHECK(reused->frontier(0).empty() && reused->frontier(0).capacity() >= 5000);
+        CHECK(reused->local(3).empty() && reused->local(3).capacity() >= 1003);
+        // Too few slots for a wider request: a new one is built
+        Workspace::Lease wide(64);
+        CHECK(&*wide != first && wide->threads() >= 64);
+    }
+    Workspace::release_idle();
+
+    // Repeated queries on reused workspaces give the same answers
+    const Graph g = make_graph(20000, random_edges(20000, 80000, 1, 95), true);
+    ParallelBFS::HybridBFS hybrid(g);
+    for (int round = 0; round < 3; ++round) {
+        for (int source : {0, 9999}) {
+            std::vector<std::atomic<int>> dist(g.vertex_count()), hybrid_dist(g.vertex_count());
+            ParallelBFS::optimized(g, source, dist);
+            hybrid.run(source, hybrid_dist);
+            const std::vector<int> expected = baseline_distances(g, source);
+            CHECK(ParallelBFS::get_distances(dist) == expected);
+            CHECK(ParallelBFS::get_distances(hybrid_dist) == expected);
+        }
+    }
+    return ok;
+}
+
+bool test_low_memory() {
+    bool ok = true;
+    // A random digraph with a 400-vertex tail, so levels pass LEVEL_CAP
+    std::vector<Edge> list = random_edges(5000, 20000, 1, 96);
+    for (int v = 5000; v < 5400; ++v) list.push_back({v - 1, v, 1});
+    const Graph g = make_graph(5400, list, false);
+
+    // The streaming loader builds the same CSR as from_file, edge list order included
+    const std::string file = temp_file(".txt");
+    {
+        std::vector<Edge> shuffled = list;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(96));
+        std::ofstream out(file);
+        for (const Edge& e : shuffled) out << e.u << "\t" << e.v << "\n";
+    }
+    const Graph loaded = GraphGenerator::from_file(file);
+    const CompactGraph streamed = LowMemory::load(file);
+    std::remove(file.c_str());
+    CHECK(streamed.vertex_count() == loaded.vertex_count() && streamed.edge_count() == loaded.edge_count());
+    CHECK(std::equal(streamed.offsets.begin(), streamed.offsets.end(), loaded.offsets.begin(), loaded.offsets.end()));
+    CHECK(std::equal(streamed.edges.begin(), streamed.edges.end(), loaded.edges.begin(), loaded.edges.end()));
+    CHECK(streamed.memory_bytes() == LowMemory::project(5400, loaded.edge_count()).graph_bytes);
+
+    const CompactGraph compact = LowMemory::compact(g);
+    for (int source : {0, 4999}) {
+        std::vector<uint8_t> level;
+        const LowMemory::BFSResult result = LowMemory::bfs(compact, source, level);
+        const std::vector<int> expected = baseline_distances(g, source);
+        size_t wrong = 0, reached = 0;
+        int depth = 0;
+        for (size_t v = 0; v < expected.size(); ++v) {
+            const bool reachable = expected[v] != INT_MAX;
+            reached += reachable;
+            if (reachable) depth = std::max(depth, expected[v]);
+            wrong += level[v] != (reachable ? std::min<int>(expected[v], LowMemory::LEVEL_CAP) : LowMemory::UNREACHED);
+        }
+        CHECK(level.size() == expected.size() && wrong == 0);
+        CHECK(result.reached == reached && result.levels == depth);
+    }
+    return ok;
+}
+
+bool test_hybrid_shapes() {
+    bool ok = true;
+    // Every instantiation: 16-bit IDs below 65536 vertices, 32-bit above, each symmetric or transposed
+    for (size_t V : {size_t(5000), size_t(70000)}) {
+        for (bool symmetric : {true, false}) {
+            const Graph g = make_graph(V, random_edges(V, V * 16, 1, static_cast<unsigned>(V)), symmetric);
+            ParallelBFS::HybridBFS hybrid(g);
+            CHECK(hybrid.symmetric() == symmetric);
+            CHECK(hybrid.narrow_ids() == (V < 65536));
+
+            std::vector<std::atomic<int>> dist(V);
+            hybrid.run(0, dist);
+            CHECK(hybrid.bottom_up_levels() > 0);
+            CHECK(ParallelBFS::get_distances(dist) == baseline_distances(g, 0));
+        }
+    }
+    return ok;
+}
+
+bool test_validate_result() {
+    bool ok = true;
+    // Both overloads, on the plain and the atomic level array
+    auto valid = [](const Graph& g, int source, const std::vector<int>& levels) {
+        std::vector<std::atomic<int>> dist(levels.size());
+        for (size_t v = 0; v < levels.size(); ++v) dist[v].store(levels[v]);
+        const bool plain = ParallelBFS::validate_result(g, source, levels);
+        return plain == ParallelBFS::validate_result(g, source, dist) ? int(plain) : -1;
+    };
+
+    // 0 -> 1 -> 2 -> 3 and 0 -> 4; 5 is isolated
+    const Graph g = make_graph(6, {{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {0, 4, 1}}, false);
+    const std::vector<int> good = {0, 1, 2, 3, 1, INT_MAX};
+    CHECK(valid(g, 0, good) == 1);
+    CHECK(baseline_distances(g, 0) == good);
+
+    auto broken = [&](int v, int level) {
+        std::vector<int> levels = good;
+        levels[v] = level;
+        return valid(g, 0, levels);
+    };
+    CHECK(broken(0, 1) == 0);        // Source off level 0
+    CHECK(broken(4, 0) == 0);        // A second vertex at level 0
+    CHECK(broken(5, -1) == 0);       // Negative level
+    CHECK(broken(2, 3) == 0);        // Edge 1 -> 2 skips a level
+    CHECK(broken(3, INT_MAX) == 0);  // Edge 2 -> 3 leaves the reached set
+    CHECK(broken(3, 2) == 0);        // 3 has no in-neighbour at level 1
+    CHECK(broken(5, 2) == 0);        // Isolated vertex marked reached
+    CHECK(valid(g, 6, good) == 0);
+    CHECK(valid(g, 0, {0, 1, 2, 3, 1}) == 0);
+
+    // Every single-vertex change to a real BFS result is caught
+    const Graph r = make_graph(3000, random_edges(3000, 6000, 1, 98), false);
+    const std::vector<int> levels = baseline_distances(r, 0);
+    CHECK(valid(r, 0, levels) == 1);
+    for (int v = 1; v < 3000; v += 97) {
+        std::vector<int> changed = levels;
+        changed[v] = levels[v] == INT_MAX ? 1 : levels[v] + 1;
+        CHECK(valid(r, 0, changed) == 0);
+    }
+    return ok;
+}
+
+bool same_metadata(const GraphMetadata& a, const GraphMetadata& b) {
+    return a.max_degree == b.max_degree && a.degree_histogram == b.degree_histogram && a.hub_degree == b.hub_degree &&
+           a.hubs == b.hubs && a.symmetric == b.symmetric;
+}
+
+bool test_graph_stats() {
+    bool ok = true;
+    // 0: [2, 1] unsorted, 1: [0, 0] duplicate, 2: [2, 7] self-loop and invalid target; 3 and 4 isolated
+    const ParallelBFS::GraphStats dirty = ParallelBFS::graph_stats(Graph({0, 2, 4, 6, 6, 6}, {2, 1, 0, 0, 2, 7}));
+    CHECK(dirty.vertices == 5 && dirty.edges == 6);
+    CHECK(dirty.min_degree == 0 && dirty.max_degree == 2);
+    CHECK(dirty.self_loops == 1 && dirty.duplicate_edges == 1 && dirty.invalid_targets == 1 && dirty.unsorted_lists == 1);
+    CHECK(dirty.isolated == 2);
+    CHECK(!dirty.clean() && !dirty.metadata.symmetric);
+
+    // Symmetric apart from list order: clean, but not symmetric for the engines
+    const Graph unsorted({0, 2, 3, 4}, {2, 1, 0, 0});
+    const ParallelBFS::GraphStats stats = ParallelBFS::graph_stats(unsorted);
+    CHECK(stats.unsorted_lists == 1 && stats.clean());
+    CHECK(stats.symmetry_ratio == 1.0 && !stats.metadata.symmetric);
+    CHECK(same_metadata(stats.metadata, GraphMetadata::compute(unsorted.offsets, unsorted.edges)));
+
+    for (bool symmetric : {true, false}) {
+        const Graph g = make_graph(5000, random_edges(5000, 40000, 1, 99), symmetric);
+        const ParallelBFS::GraphStats random = ParallelBFS::graph_stats(g);
+        CHECK(random.clean() && random.unsorted_lists == 0);
+        CHECK((random.symmetry_ratio == 1.0) == symmetric);
+        CHECK(same_metadata(random.metadata, GraphMetadata::compute(g.offsets, g.edges)));
+    }
+
+    CHECK(throws([] { ParallelBFS::graph_stats(Graph({0, 2, 1}, {1, 0})); }));
+    return ok;
+}
+
+bool test_binary_file() {
+    bool ok = true;
+    const std::string path = temp_file(".bin");
+    auto read_bytes = [&] {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    };
+    auto write_bytes = [&](const std::string& bytes) {
+        std::ofstream(path, std::ios::binary) << bytes;
+    };
+    // Loads a copy of the saved file with one 32-bit field overwritten
+    auto load_patched = [&](const std::string& saved, size_t at, uint32_t value) {
+        std::string bytes = saved;
+        std::memcpy(&bytes[at], &value, sizeof(value));
+        write_bytes(bytes);
+        return GraphGenerator::from_binary(path);
+    };
+    constexpr size_t HEADER = 56, FLAGS = 12, MAX_DEGREE = 32;
+
+    for (bool symmetric : {true, false}) {
+        const Graph g = make_graph(2000, random_edges(2000, 10000, 50, 100), symmetric, true);
+        GraphGenerator::save_binary(g, path);
+        const std::string saved = read_bytes();
+
+        const Graph loaded = GraphGenerator::from_binary(path);
+        CHECK(loaded.offsets == g.offsets && loaded.edges == g.edges && loaded.weights == g.weights);
+        CHECK(same_metadata(loaded.metadata(), GraphMetadata::compute(g.offsets, g.edges)));
+        CHECK(loaded.metadata().symmetric == symmetric);
+
+        uint32_t flags;
+        std::memcpy(&flags, &saved[FLAGS], sizeof(flags));
+        if (symmetric) {
+            // A cleared flag only costs the engines a transpose
+            CHECK(!load_patched(saved, FLAGS, flags & ~2u).metadata().symmetric);
+        } else {
+            CHECK(throws([&] { load_patched(saved, FLAGS, flags | 2u); }));
+        }
+        CHECK(throws([&] { load_patched(saved, MAX_DEGREE, g.metadata().max_degree + 1); }));
+        const size_t first_edge = HEADER + g.offsets.size() * sizeof(int);
+        CHECK(throws([&] { load_patched(saved, first_edge, 2000); }));
+        CHECK(throws([&] { load_patched(saved, first_edge, uint32_t(-1)); }));
+
+        write_bytes(saved.substr(0, saved.size() - 1));
+        CHECK(throws([&] { GraphGenerator::from_binary(path); }));
+    }
+    std::remove(path.c_str());
+    return ok;
+}
+
+struct Case {
+    const char* name;
+    bool (*test)();
+};
+
+const Case cases[] = {
+    {"bipartite", test_bipartite},
+    {"delta_stepping", test_delta_stepping},
+    {"weighted_file", test_weighted_file},
+    {"dial", test_dial},
+    {"hyperanf", test_hyperanf},
+    {"apsp", test_apsp},
+    {"kcore", test_kcore},
+    {"partition", test_partition},
+    {"distance_histogram", test_distance_histogram},
+    {"thread_pool", test_thread_pool},
+    {"frontier_bag", test_frontier_bag},
+    {"topology", test_topology},
+    {"numa_bfs", test_numa_bfs},
+    {"async_bfs", test_async_bfs},
+    {"parallel_backend", test_parallel_backend},
+    {"simd_kernels", test_simd_kernels},
+    {"hybrid_bfs", test_hybrid_bfs},
+    {"prefetch", test_prefetch},
+    {"binned_bfs", test_binned_bfs},
+    {"distributed_bfs", test_distributed_bfs},
+    {"distributed_bfs_2d", test_distributed_bfs_2d},
+    {"workspace", test_workspace},
+    {"low_memory", test_low_memory},
+    {"hybrid_shapes", test_hybrid_shapes},
+    {"validate_result", test_validate_result},
+    {"graph_stats", test_graph_stats},
+    {"binary_file", test_binary_file},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int failures = 0;
+    for (const Case& c : cases) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) selected |= std::strncmp(c.name, argv[i], std::strlen(argv[i])) == 0;
+        if (!selected) continue;
+
+        bool passed = false;
+        try {
+            passed = c.test();
+        } catch (const std::exception& e) {
+            std::cerr << "  threw: " << e.what() << "\n";
+        }
+        std::cout << (passed ? "PASS " : "FAIL ") << c.name << "\n";
+        failures += !passed;
+    }
+    return failures;
+}